@@ -50,43 +50,29 @@ namespace
     return std::is_permutation(plg1.points.cbegin(), plg1.points.cend(), plg2.points.cbegin());
   }
 
-  struct RightAngleCheck
+  struct FlagCheck
   {
-    const demehin::Polygon& plg;
+    demehin::ShapeFlags flag;
 
-    bool operator()(size_t ind) const
+    bool operator()(demehin::ShapeFlags flags) const
     {
-      size_t n  = plg.points.size();
-      auto prev = plg.points[(ind + n - 1) % n];
-      auto curr = plg.points[ind];
-      auto next = plg.points[(ind + 1) % n];
-
-      double dx1 = curr.x - prev.x;
-      double dy1 = curr.y - prev.y;
-      double dx2 = next.x - curr.x;
-      double dy2 = next.y - curr.y;
-
-      double scalar = dx1 * dx2 + dy1 * dy2;
-      return scalar == 0;
+      return (flags & flag) != 0;
     }
   };
 
-  bool hasRights(const Polygon& plg)
+  size_t countFlag(const std::vector< demehin::ShapeFlags >& flags, demehin::ShapeFlags flag)
   {
-    std::vector< size_t > inds(plg.points.size());
-    std::iota(inds.begin(), inds.end(), 0);
-
-    return std::any_of(inds.begin(), inds.end(), RightAngleCheck{ plg });
+    return std::count_if(flags.cbegin(), flags.cend(), FlagCheck{ flag });
   }
 
-  size_t countEven(const std::vector< Polygon >& plgs)
+  size_t countEven(const std::vector< demehin::ShapeFlags >& flags)
   {
-    return std::count_if(plgs.cbegin(), plgs.cend(), isEvenVrts);
+    return flags.size() - countFlag(flags, demehin::ODD_VERTEXES);
   }
 
-  size_t countOdd(const std::vector< Polygon >& plgs)
+  size_t countOdd(const std::vector< demehin::ShapeFlags >& flags)
   {
-    return std::count_if(plgs.cbegin(), plgs.cend(), isOddVrts);
+    return countFlag(flags, demehin::ODD_VERTEXES);
   }
 
   size_t countVrt(const std::vector< Polygon >& plgs, size_t vrt_cnt)
@@ -237,11 +223,12 @@ void demehin::printMinValueOf(std::istream& in, const std::vector< Polygon >& pl
   subcmds.at(subcommand)();
 }
 
-void demehin::printCountOf(std::istream& in, const std::vector< Polygon >& plgs, std::ostream& out)
+void demehin::printCountOf(std::istream& in, const std::vector< Polygon >& plgs, const std::vector< ShapeFlags >& flags,
+  std::ostream& out)
 {
   std::unordered_map< std::string, std::function< size_t() > > subcmds;
-  subcmds["EVEN"] = std::bind(countEven, std::cref(plgs));
-  subcmds["ODD"] = std::bind(countOdd, std::cref(plgs));
+  subcmds["EVEN"] = std::bind(countEven, std::cref(flags));
+  subcmds["ODD"] = std::bind(countOdd, std::cref(flags));
 
   std::string subcommand;
   in >> subcommand;
@@ -274,7 +261,7 @@ void demehin::printPermsCnt(std::istream& in, const std::vector< Polygon >& plgs
   out << std::count_if(plgs.cbegin(), plgs.cend(), std::bind(isPerm, std::placeholders::_1, plg));
 }
 
-void demehin::printRightsCnt(const std::vector< Polygon >& plgs, std::ostream& out)
+void demehin::printRightsCnt(const std::vector< ShapeFlags >& flags, std::ostream& out)
 {
-  out << count_if(plgs.cbegin(), plgs.cend(), hasRights);
+  out << countFlag(flags, RIGHT_ANGLE);
 }
@@ -21,6 +21,113 @@ namespace
       return area;
     }
   };
+
+#ifdef __SIZEOF_INT128__
+  using WideProduct = __int128;
+#else
+  using WideProduct = long long;
+#endif
+
+  struct Edge
+  {
+    long long dx;
+    long long dy;
+  };
+
+  Edge makeEdge(const demehin::Point& from, const demehin::Point& to)
+  {
+    return Edge{ static_cast< long long >(to.x) - from.x, static_cast< long long >(to.y) - from.y };
+  }
+
+  WideProduct dot(const Edge& e1, const Edge& e2)
+  {
+    return static_cast< WideProduct >(e1.dx) * e2.dx + static_cast< WideProduct >(e1.dy) * e2.dy;
+  }
+
+  WideProduct cross(const Edge& e1, const Edge& e2)
+  {
+    return static_cast< WideProduct >(e1.dx) * e2.dy - static_cast< WideProduct >(e1.dy) * e2.dx;
+  }
+
+  struct ShapeClassifier
+  {
+    demehin::Point first{ 0, 0 };
+    demehin::Point prev{ 0, 0 };
+    Edge firstEdge{ 0, 0 };
+    Edge prevEdge{ 0, 0 };
+    size_t points = 0;
+    size_t edges = 0;
+    size_t rightAngles = 0;
+    size_t leftTurns = 0;
+    size_t rightTurns = 0;
+    bool axisAligned = true;
+    bool zeroEdge = false;
+
+    void operator()(const demehin::Point& pt)
+    {
+      if (points++ == 0)
+      {
+        first = pt;
+      }
+      else
+      {
+        addEdge(makeEdge(prev, pt));
+      }
+      prev = pt;
+    }
+
+    void addEdge(const Edge& edge)
+    {
+      if (edges++ == 0)
+      {
+        firstEdge = edge;
+      }
+      else
+      {
+        addAngle(prevEdge, edge);
+      }
+      axisAligned = axisAligned && (edge.dx == 0 || edge.dy == 0);
+      zeroEdge = zeroEdge || (edge.dx == 0 && edge.dy == 0);
+      prevEdge = edge;
+    }
+
+    void addAngle(const Edge& in, const Edge& out)
+    {
+      rightAngles += dot(in, out) == 0;
+      WideProduct turn = cross(in, out);
+      leftTurns += turn > 0;
+      rightTurns += turn < 0;
+    }
+
+    demehin::ShapeFlags finish()
+    {
+      addEdge(makeEdge(prev, first));
+      addAngle(prevEdge, firstEdge);
+
+      demehin::ShapeFlags flags = 0;
+      if (rightAngles != 0)
+      {
+        flags |= demehin::RIGHT_ANGLE;
+      }
+      if (points == 4 && rightAngles == 4 && !zeroEdge)
+      {
+        flags |= demehin::RECTANGLE;
+      }
+      if (axisAligned)
+      {
+        flags |= demehin::AXIS_ALIGNED;
+      }
+      if ((leftTurns == 0) != (rightTurns == 0))
+      {
+        flags |= demehin::CONVEX;
+      }
+      if (points % 2 != 0)
+      {
+        flags |= demehin::ODD_VERTEXES;
+      }
+      return flags;
+    }
+  };
 }
 
 bool demehin::operator==(const Point& pt1, const Point& pt2)
@@ -76,3 +183,18 @@ double demehin::getPlgArea(const Polygon& plg)
   AreaCalc area{ plg.points[0], plg.points[1] };
   return std::accumulate(plg.points.begin() + 2, plg.points.end(), 0.0, std::ref(area));
 }
+
+demehin::ShapeFlags demehin::classifyShape(const Polygon& plg)
+{
+  if (plg.points.empty())
+  {
+    return 0;
+  }
+  return std::for_each(plg.points.begin(), plg.points.end(), ShapeClassifier{ }).finish();
+}
+
+void demehin::classifyShapes(const std::vector< Polygon >& plgs, std::vector< ShapeFlags >& flags)
+{
+  flags.reserve(flags.size() + plgs.size());
+  std::transform(plgs.begin(), plgs.end(), std::back_inserter(flags), classifyShape);
+}
@@ -21,6 +21,20 @@ namespace demehin
   std::istream& operator>>(std::istream&, Polygon&);
 
   double getPlgArea(const Polygon&);
+
+  using ShapeFlags = unsigned char;
+
+  enum ShapeFlag: ShapeFlags
+  {
+    RIGHT_ANGLE = 1 << 0,
+    RECTANGLE = 1 << 1,
+    AXIS_ALIGNED = 1 << 2,
+    CONVEX = 1 << 3,
+    ODD_VERTEXES = 1 << 4
+  };
+
+  ShapeFlags classifyShape(const Polygon&);
+  void classifyShapes(const std::vector< Polygon >&, std::vector< ShapeFlags >&);
 }
 
 #endif
@@ -0,0 +1,242 @@
+#include "loader.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DEMEHIN_LOADER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  using demehin::Point;
+  using demehin::Polygon;
+
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const char* filename);
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const char* begin() const noexcept;
+    const char* end() const noexcept;
+
+  private:
+    const char* data_;
+    size_t size_;
+    std::vector< char > buffer_;
+  };
+
+  MappedFile::MappedFile(const char* filename):
+    data_(nullptr),
+    size_(0),
+    buffer_()
+  {
+#ifdef DEMEHIN_LOADER_MMAP
+    int fd = ::open(filename, O_RDONLY);
+    if (fd == -1)
+    {
+      return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+      void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+        ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        data_ = static_cast< const char* >(addr);
+        size_ = st.st_size;
+      }
+    }
+    ::close(fd);
+    if (data_)
+    {
+      return;
+    }
+#endif
+    std::ifstream file(filename, std::ios::binary);
+    buffer_.assign(std::istreambuf_iterator< char >(file), std::istreambuf_iterator< char >());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+
+  MappedFile::~MappedFile()
+  {
+#ifdef DEMEHIN_LOADER_MMAP
+    if (data_ && buffer_.empty())
+    {
+      ::munmap(const_cast< char* >(data_), size_);
+    }
+#endif
+  }
+
+  const char* MappedFile::begin() const noexcept
+  {
+    return data_;
+  }
+
+  const char* MappedFile::end() const noexcept
+  {
+    return data_ + size_;
+  }
+
+  bool isSpace(char c)
+  {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+  bool isDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  struct DigitsAccumulator
+  {
+    bool& overflow;
+
+    unsigned long long operator()(unsigned long long num, char c) const
+    {
+      constexpr unsigned long long max = std::numeric_limits< unsigned long long >::max();
+      unsigned long long digit = c - '0';
+      if (num > (max - digit) / 10)
+      {
+        overflow = true;
+      }
+      return num * 10 + digit;
+    }
+  };
+
+  // Mirrors the way the istream-based reading consumed characters, so
+  // a failure leaves the cursor where the stream would have stopped
+  struct Scanner
+  {
+    const char* pos;
+    const char* end;
+
+    void skipSpaces()
+    {
+      pos = std::find_if_not(pos, end, isSpace);
+    }
+
+    bool readMagnitude(unsigned long long& num, bool& negative)
+    {
+      skipSpaces();
+      negative = (pos != end && *pos == '-');
+      if (pos != end && (*pos == '-' || *pos == '+'))
+      {
+        ++pos;
+      }
+      const char* digitsEnd = std::find_if_not(pos, end, isDigit);
+      if (digitsEnd == pos)
+      {
+        return false;
+      }
+      bool overflow = false;
+      num = std::accumulate(pos, digitsEnd, 0ULL, DigitsAccumulator{ overflow });
+      pos = digitsEnd;
+      return !overflow;
+    }
+
+    bool readCount(size_t& cnt)
+    {
+      unsigned long long num = 0;
+      bool negative = false;
+      if (!readMagnitude(num, negative) || num > std::numeric_limits< size_t >::max())
+      {
+        return false;
+      }
+      cnt = negative ? -num : num;
+      return true;
+    }
+
+    bool readInt(int& num)
+    {
+      unsigned long long mag = 0;
+      bool negative = false;
+      if (!readMagnitude(mag, negative))
+      {
+        return false;
+      }
+      constexpr unsigned long long max = std::numeric_limits< int >::max();
+      if (mag > max + (negative ? 1 : 0))
+      {
+        return false;
+      }
+      num = negative ? static_cast< int >(-static_cast< long long >(mag)) : static_cast< int >(mag);
+      return true;
+    }
+
+    bool readDelimiter(char exp)
+    {
+      skipSpaces();
+      if (pos == end)
+      {
+        return false;
+      }
+      return std::tolower(*pos++) == exp;
+    }
+
+    bool readPoint(Point& pt)
+    {
+      return readDelimiter('(') && readInt(pt.x) && readDelimiter(';') && readInt(pt.y) && readDelimiter(')');
+    }
+
+    bool readPolygon(Polygon& plg)
+    {
+      size_t vrtx_cnt = 0;
+      if (!readCount(vrtx_cnt) || vrtx_cnt < 3)
+      {
+        return false;
+      }
+      std::vector< Point > pts;
+      pts.reserve(std::min< size_t >(vrtx_cnt, std::distance(pos, end) / 5));
+      Point pt{ 0, 0 };
+      while (pts.size() < vrtx_cnt)
+      {
+        if (!readPoint(pt))
+        {
+          return false;
+        }
+        pts.push_back(pt);
+      }
+      plg.points = std::move(pts);
+      return true;
+    }
+
+    void skipLine()
+    {
+      pos = std::find(pos, end, '\n');
+      if (pos != end)
+      {
+        ++pos;
+      }
+    }
+  };
+}
+
+void demehin::loadPolygons(const char* filename, std::vector< Polygon >& plgs)
+{
+  MappedFile file(filename);
+  Scanner scanner{ file.begin(), file.end() };
+  Polygon plg;
+  while (scanner.pos != scanner.end)
+  {
+    if (scanner.readPolygon(plg))
+    {
+      plgs.push_back(std::move(plg));
+    }
+    else
+    {
+      scanner.skipLine();
+    }
+  }
+}
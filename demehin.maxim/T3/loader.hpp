@@ -0,0 +1,11 @@
+#ifndef LOADER_HPP
+#define LOADER_HPP
+#include <vector>
+#include "geometry.hpp"
+
+namespace demehin
+{
+  void loadPolygons(const char* filename, std::vector< Polygon >& plgs);
+}
+
+#endif
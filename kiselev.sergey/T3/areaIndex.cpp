@@ -0,0 +1,31 @@
+#include "areaIndex.hpp"
+#include <algorithm>
+#include <iterator>
+
+kiselev::AreaIndex::AreaIndex(const std::vector< Polygon >& polygons)
+{
+  areas_.reserve(polygons.size());
+  std::transform(polygons.begin(), polygons.end(), std::back_inserter(areas_), getArea);
+  std::sort(areas_.begin(), areas_.end());
+}
+
+void kiselev::AreaIndex::insert(const Polygon& polygon)
+{
+  const double area = getArea(polygon);
+  areas_.insert(std::upper_bound(areas_.begin(), areas_.end(), area), area);
+}
+
+void kiselev::AreaIndex::erase(const Polygon& polygon)
+{
+  const double area = getArea(polygon);
+  auto it = std::lower_bound(areas_.begin(), areas_.end(), area);
+  if (it != areas_.end() && *it == area)
+  {
+    areas_.erase(it);
+  }
+}
+
+size_t kiselev::AreaIndex::countLess(double area) const
+{
+  return std::distance(areas_.begin(), std::lower_bound(areas_.begin(), areas_.end(), area));
+}
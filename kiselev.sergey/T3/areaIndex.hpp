@@ -0,0 +1,20 @@
+#ifndef AREAINDEX_HPP
+#define AREAINDEX_HPP
+#include <cstddef>
+#include <vector>
+#include "polygon.hpp"
+
+namespace kiselev
+{
+  class AreaIndex
+  {
+  public:
+    explicit AreaIndex(const std::vector< Polygon >&);
+    void insert(const Polygon&);
+    void erase(const Polygon&);
+    size_t countLess(double) const;
+  private:
+    std::vector< double > areas_;
+  };
+}
+#endif
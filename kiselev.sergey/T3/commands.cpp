@@ -23,6 +23,16 @@ namespace
     return !isEven(poly);
   }
 
+  struct IntersectsWith
+  {
+    const std::vector< kiselev::Polygon >& polygons;
+    const kiselev::Polygon& polygon;
+    bool operator()(size_t index) const
+    {
+      return kiselev::intersects(polygons[index], polygon);
+    }
+  };
+
   bool acceptAll(const kiselev::Polygon&)
   {
     return true;
@@ -124,112 +134,142 @@ namespace
   {
     out << countIf(polygons, VertexPred{ n }) << "\n";
   }
-}
 
-void kiselev::doAreaCommand(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
-{
-  std::string subcommand;
-  in >> subcommand;
-  double res = 0.0;
-  std::map< std::string, std::function< double() > > subcommands;
-  subcommands["EVEN"] = std::bind(areaEven, std::cref(polygons));
-  subcommands["ODD"] = std::bind(areaOdd, std::cref(polygons));
-  subcommands["MEAN"] = std::bind(areaMean, std::cref(polygons));
-  try
+  void printArea(const std::function< double() >& area, std::ostream& out)
+  {
+    double res = area();
+    detail::ScopeGuard scope(out);
+    out << std::fixed << std::setprecision(1) << res << "\n";
+  }
+
+  void printRects(const std::vector< kiselev::Polygon >& polygons, std::ostream& out)
+  {
+    out << std::count_if(polygons.begin(), polygons.end(), kiselev::isRect) << "\n";
+  }
+
+  void printLessArea(const kiselev::AreaIndex& areas, const kiselev::Polygon& poly, std::ostream& out)
   {
-    res = subcommands.at(subcommand)();
+    out << areas.countLess(kiselev::getArea(poly)) << "\n";
   }
-  catch (...)
+
+  void printIntersections(const std::vector< kiselev::Polygon >& polygons, const kiselev::RTree& tree,
+    const kiselev::Polygon& poly, std::ostream& out)
+  {
+    const std::vector< size_t > candidates = tree.query(kiselev::getBox(poly));
+    out << std::count_if(candidates.begin(), candidates.end(), IntersectsWith{ polygons, poly }) << "\n";
+  }
+
+  size_t parseVertexCount(const std::string& subcommand)
   {
     size_t n = std::stoull(subcommand);
     if (n < 3)
     {
       throw std::logic_error("Few vertices");
     }
-    res = areaNum(polygons, n);
+    return n;
   }
-  detail::ScopeGuard scope(out);
-  out << std::fixed << std::setprecision(1) << res << "\n";
-}
 
-void kiselev::doMaxCommand(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
-{
-  std::string subcommand;
-  in >> subcommand;
-  if (polygons.empty())
-  {
-    throw std::logic_error("No polygons");
-  }
-  std::map< std::string, std::function< void() > > subcommands;
-  subcommands["AREA"] = std::bind(maxArea, std::cref(polygons), std::ref(out));
-  subcommands["VERTEXES"] = std::bind(maxVertex, std::cref(polygons), std::ref(out));
-  try
+  kiselev::Polygon parsePolygonArgument(std::istream& in)
   {
-    subcommands.at(subcommand)();
+    kiselev::Polygon poly;
+    in >> poly;
+    if (!in || in.peek() != '\n')
+    {
+      in.clear();
+      throw std::logic_error("<INVALID COMMAND>");
+    }
+    return poly;
   }
-  catch (...)
+
+  using TaskMap = std::map< std::string, kiselev::Task >;
+
+  kiselev::Task selectExtremum(std::istream& in, const std::vector< kiselev::Polygon >& polygons, const TaskMap& tasks)
   {
-    throw std::logic_error("Unknown command");
+    std::string subcommand;
+    in >> subcommand;
+    if (polygons.empty())
+    {
+      throw std::logic_error("No polygons");
+    }
+    try
+    {
+      return tasks.at(subcommand);
+    }
+    catch (...)
+    {
+      throw std::logic_error("Unknown command");
+    }
   }
 }
 
-void kiselev::doMinCommand(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
+kiselev::Task kiselev::parseAreaCommand(std::istream& in, const std::vector< Polygon >& polygons)
 {
+  using namespace std::placeholders;
   std::string subcommand;
   in >> subcommand;
-  if (polygons.empty())
-  {
-    throw std::logic_error("No polygons");
-  }
-  std::map< std::string, std::function< void() > > subcommands;
-  subcommands["AREA"] = std::bind(minArea, std::cref(polygons), std::ref(out));
-  subcommands["VERTEXES"] = std::bind(minVertex, std::cref(polygons), std::ref(out));
-  try
+  std::map< std::string, std::function< double() > > subcommands;
+  subcommands["EVEN"] = std::bind(areaEven, std::cref(polygons));
+  subcommands["ODD"] = std::bind(areaOdd, std::cref(polygons));
+  if (!polygons.empty())
   {
-    subcommands.at(subcommand)();
+    subcommands["MEAN"] = std::bind(areaMean, std::cref(polygons));
   }
-  catch (...)
+  auto area = subcommands.find(subcommand);
+  if (area != subcommands.end())
   {
-    throw std::logic_error("Unknown command");
+    return std::bind(printArea, area->second, _1);
   }
+  std::function< double() > areaOfCount = std::bind(areaNum, std::cref(polygons), parseVertexCount(subcommand));
+  return std::bind(printArea, areaOfCount, _1);
+}
+
+kiselev::Task kiselev::parseMaxCommand(std::istream& in, const std::vector< Polygon >& polygons)
+{
+  using namespace std::placeholders;
+  TaskMap subcommands;
+  subcommands["AREA"] = std::bind(maxArea, std::cref(polygons), _1);
+  subcommands["VERTEXES"] = std::bind(maxVertex, std::cref(polygons), _1);
+  return selectExtremum(in, polygons, subcommands);
 }
 
-void kiselev::doCountCommand(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
+kiselev::Task kiselev::parseMinCommand(std::istream& in, const std::vector< Polygon >& polygons)
 {
+  using namespace std::placeholders;
+  TaskMap subcommands;
+  subcommands["AREA"] = std::bind(minArea, std::cref(polygons), _1);
+  subcommands["VERTEXES"] = std::bind(minVertex, std::cref(polygons), _1);
+  return selectExtremum(in, polygons, subcommands);
+}
+
+kiselev::Task kiselev::parseCountCommand(std::istream& in, const std::vector< Polygon >& polygons)
+{
+  using namespace std::placeholders;
   std::string subcommand;
   in >> subcommand;
-  std::map< std::string, std::function< void() > > subcommands;
-  subcommands["EVEN"] = std::bind(countEven, std::cref(polygons), std::ref(out));
-  subcommands["ODD"] = std::bind(countOdd, std::cref(polygons), std::ref(out));
-  try
+  TaskMap subcommands;
+  subcommands["EVEN"] = std::bind(countEven, std::cref(polygons), _1);
+  subcommands["ODD"] = std::bind(countOdd, std::cref(polygons), _1);
+  auto count = subcommands.find(subcommand);
+  if (count != subcommands.end())
   {
-    subcommands.at(subcommand)();
-  }
-  catch (...)
-  {
-    size_t n = std::stoull(subcommand);
-    if (n < 3)
-    {
-      throw std::logic_error("Few vertices");
-    }
-    countNum(polygons, out, n);
+    return count->second;
   }
+  return std::bind(countNum, std::cref(polygons), _1, parseVertexCount(subcommand));
 }
 
-void kiselev::doRectsCommand(std::ostream& out, const std::vector< Polygon >& polygons)
+kiselev::Task kiselev::parseRectsCommand(const std::vector< Polygon >& polygons)
 {
-  out << std::count_if(polygons.begin(), polygons.end(), isRect) << "\n";
+  return std::bind(printRects, std::cref(polygons), std::placeholders::_1);
 }
 
-void kiselev::doLessAreaCommand(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
+kiselev::Task kiselev::parseLessAreaCommand(std::istream& in, const AreaIndex& areas)
+{
+  return std::bind(printLessArea, std::cref(areas), parsePolygonArgument(in), std::placeholders::_1);
+}
+
+kiselev::Task kiselev::parseIntersectionsCommand(std::istream& in, const std::vector< Polygon >& polygons,
+  const RTree& tree)
 {
-  Polygon poly;
-  in >> poly;
-  if (!in || in.peek() != '\n')
-  {
-    in.clear();
-    throw std::logic_error("<INVALID COMMAND>");
-  }
   using namespace std::placeholders;
-  out << std::count_if(polygons.begin(), polygons.end(), std::bind(compareArea, _1, poly)) << "\n";
+  return std::bind(printIntersections, std::cref(polygons), std::cref(tree), parsePolygonArgument(in), _1);
 }
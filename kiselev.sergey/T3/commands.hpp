@@ -1,15 +1,19 @@
 #ifndef COMMANDS_HPP
 #define COMMANDS_HPP
 #include "polygon.hpp"
+#include "areaIndex.hpp"
+#include "rTree.hpp"
+#include "pipeline.hpp"
 #include <iosfwd>
 #include <vector>
 namespace kiselev
 {
-  void doAreaCommand(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void doMaxCommand(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void doMinCommand(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void doCountCommand(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void doLessAreaCommand(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void doRectsCommand(std::ostream&, const std::vector< Polygon >&);
+  Task parseAreaCommand(std::istream&, const std::vector< Polygon >&);
+  Task parseMaxCommand(std::istream&, const std::vector< Polygon >&);
+  Task parseMinCommand(std::istream&, const std::vector< Polygon >&);
+  Task parseCountCommand(std::istream&, const std::vector< Polygon >&);
+  Task parseLessAreaCommand(std::istream&, const AreaIndex&);
+  Task parseRectsCommand(const std::vector< Polygon >&);
+  Task parseIntersectionsCommand(std::istream&, const std::vector< Polygon >&, const RTree&);
 }
 #endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <iostream>
@@ -6,8 +7,12 @@
 #include <map>
 #include <string>
 #include <functional>
+#include <thread>
 #include "polygon.hpp"
 #include "commands.hpp"
+#include "areaIndex.hpp"
+#include "rTree.hpp"
+#include "pipeline.hpp"
 int main(int argc, char** argv)
 {
   using namespace kiselev;
@@ -31,20 +36,26 @@ int main(int argc, char** argv)
     }
   }
 
-  std::map< std::string, std::function< void() > > commands;
-  commands["AREA"] = std::bind(doAreaCommand, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  commands["MAX"] = std::bind(doMaxCommand, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  commands["MIN"] = std::bind(doMinCommand, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  commands["COUNT"] = std::bind(doCountCommand, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  commands["LESSAREA"] = std::bind(doLessAreaCommand, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  commands["RECTS"] = std::bind(doRectsCommand, std::ref(std::cout), std::cref(polygons));
+  AreaIndex areas(polygons);
+  RTree tree(polygons);
+  std::map< std::string, std::function< Task() > > commands;
+  commands["AREA"] = std::bind(parseAreaCommand, std::ref(std::cin), std::cref(polygons));
+  commands["MAX"] = std::bind(parseMaxCommand, std::ref(std::cin), std::cref(polygons));
+  commands["MIN"] = std::bind(parseMinCommand, std::ref(std::cin), std::cref(polygons));
+  commands["COUNT"] = std::bind(parseCountCommand, std::ref(std::cin), std::cref(polygons));
+  commands["LESSAREA"] = std::bind(parseLessAreaCommand, std::ref(std::cin), std::cref(areas));
+  commands["RECTS"] = std::bind(parseRectsCommand, std::cref(polygons));
+  commands["INTERSECTIONS"] = std::bind(parseIntersectionsCommand, std::ref(std::cin), std::cref(polygons),
+    std::cref(tree));
 
+  const size_t workers = std::max(std::thread::hardware_concurrency(), 1u);
+  Pipeline pipeline(std::cout, workers, workers * 256);
   std::string command;
   while (!(std::cin >> command).eof())
   {
     try
     {
-      commands.at(command)();
+      pipeline.submit(commands.at(command)());
     }
     catch (...)
     {
@@ -53,7 +64,8 @@ int main(int argc, char** argv)
         std::cin.clear(std::cin.rdstate() ^ std::ios::failbit);
       }
       std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
-      std::cout << "<INVALID COMMAND>\n";
+      pipeline.reject();
     }
   }
+  pipeline.finish();
 }
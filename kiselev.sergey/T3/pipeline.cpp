@@ -0,0 +1,137 @@
+#include "pipeline.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+  const char* const invalidCommand = "<INVALID COMMAND>\n";
+
+  std::string runTask(const kiselev::Task& task)
+  {
+    std::ostringstream out;
+    task(out);
+    return out.str();
+  }
+}
+
+kiselev::Pipeline::Pipeline(std::ostream& out, size_t workers, size_t capacity):
+  out_(out),
+  capacity_(std::max< size_t >(capacity, 1)),
+  done_(false)
+{
+  workers_.reserve(std::max< size_t >(workers, 1));
+  std::generate_n(std::back_inserter(workers_), workers_.capacity(), std::bind(&Pipeline::startWorker, this));
+  committer_ = std::thread(&Pipeline::commit, this);
+}
+
+kiselev::Pipeline::~Pipeline()
+{
+  finish();
+}
+
+void kiselev::Pipeline::submit(const Task& task)
+{
+  std::packaged_task< std::string() > job(std::bind(runTask, task));
+  std::future< std::string > result = job.get_future();
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    tasks_.push_back(std::move(job));
+  }
+  hasTask_.notify_one();
+  push(std::move(result));
+}
+
+void kiselev::Pipeline::reject()
+{
+  std::promise< std::string > answer;
+  answer.set_value(invalidCommand);
+  push(answer.get_future());
+}
+
+void kiselev::Pipeline::finish()
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (done_)
+    {
+      return;
+    }
+    done_ = true;
+  }
+  hasTask_.notify_all();
+  hasResult_.notify_all();
+  std::for_each(workers_.begin(), workers_.end(), std::mem_fn(&std::thread::join));
+  committer_.join();
+  out_.flush();
+}
+
+std::thread kiselev::Pipeline::startWorker()
+{
+  return std::thread(&Pipeline::work, this);
+}
+
+void kiselev::Pipeline::push(std::future< std::string >&& result)
+{
+  // results_ is the only bounded queue, so waiting here cannot block the committer that drains it
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (results_.size() >= capacity_)
+  {
+    hasRoom_.wait(lock);
+  }
+  results_.push_back(std::move(result));
+  lock.unlock();
+  hasResult_.notify_one();
+}
+
+void kiselev::Pipeline::work()
+{
+  while (true)
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    while (tasks_.empty() && !done_)
+    {
+      hasTask_.wait(lock);
+    }
+    if (tasks_.empty())
+    {
+      return;
+    }
+    std::packaged_task< std::string() > job = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    job();
+  }
+}
+
+void kiselev::Pipeline::commit()
+{
+  while (true)
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    while (results_.empty() && !done_)
+    {
+      hasResult_.wait(lock);
+    }
+    if (results_.empty())
+    {
+      return;
+    }
+    std::future< std::string > result = std::move(results_.front());
+    results_.pop_front();
+    lock.unlock();
+    hasRoom_.notify_one();
+    try
+    {
+      out_ << result.get();
+    }
+    catch (...)
+    {
+      assert(!"pipeline tasks must not throw");
+      out_ << invalidCommand;
+    }
+  }
+}
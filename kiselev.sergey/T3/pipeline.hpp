@@ -0,0 +1,48 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kiselev
+{
+  // A task runs after its command line has been read, so it must not throw:
+  // every check that can reject a command belongs to the parser that builds it.
+  using Task = std::function< void(std::ostream&) >;
+
+  class Pipeline
+  {
+  public:
+    Pipeline(std::ostream&, size_t workers, size_t capacity);
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    ~Pipeline();
+    void submit(const Task&);
+    void reject();
+    void finish();
+  private:
+    std::ostream& out_;
+    size_t capacity_;
+    bool done_;
+    std::mutex mutex_;
+    std::condition_variable hasTask_;
+    std::condition_variable hasResult_;
+    std::condition_variable hasRoom_;
+    std::deque< std::packaged_task< std::string() > > tasks_;
+    std::deque< std::future< std::string > > results_;
+    std::vector< std::thread > workers_;
+    std::thread committer_;
+    std::thread startWorker();
+    void push(std::future< std::string >&&);
+    void work();
+    void commit();
+  };
+}
+#endif
@@ -23,6 +23,53 @@ namespace
   {
     return std::sqrt(std::pow((p1.x - p2.x), 2) + std::pow((p1.y - p2.y), 2));
   }
+
+#ifdef __SIZEOF_INT128__
+  using Product = __int128;
+#else
+  using Product = long long;
+#endif
+
+  Product cross(const kiselev::Point& o, const kiselev::Point& a, const kiselev::Point& b)
+  {
+    const Product ax = static_cast< long long >(a.x) - o.x;
+    const Product ay = static_cast< long long >(a.y) - o.y;
+    const Product bx = static_cast< long long >(b.x) - o.x;
+    const Product by = static_cast< long long >(b.y) - o.y;
+    return ax * by - ay * bx;
+  }
+
+  int sign(Product value)
+  {
+    return (value > 0) - (value < 0);
+  }
+
+  bool inRange(const kiselev::Point& a, const kiselev::Point& b, const kiselev::Point& p)
+  {
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+  }
+
+  bool edgeHitsPolygon(const kiselev::Point& a, const kiselev::Point& b, const kiselev::Polygon& polygon)
+  {
+    using namespace std::placeholders;
+    const auto& points = polygon.points;
+    auto hits = std::bind(kiselev::segmentsIntersect, std::cref(a), std::cref(b), _1, _2);
+    return std::adjacent_find(points.begin(), points.end(), hits) != points.end() || hits(points.back(), points.front());
+  }
+
+  struct RayCrossing
+  {
+    const kiselev::Point& point;
+    int operator()(const kiselev::Point& a, const kiselev::Point& b) const
+    {
+      if ((a.y > point.y) == (b.y > point.y))
+      {
+        return 0;
+      }
+      const Product side = cross(a, b, point);
+      return (b.y > a.y) ? (side > 0) : (side < 0);
+    }
+  };
 }
 
 std::istream& kiselev::operator>>(std::istream& in, Point& point)
@@ -75,3 +122,37 @@ bool kiselev::isRect(const Polygon& poly)
 {
   return (poly.points.size() == 4) && (distance(poly.points[0], poly.points[2]) == distance(poly.points[1], poly.points[3]));
 }
+
+bool kiselev::segmentsIntersect(const Point& a, const Point& b, const Point& c, const Point& d)
+{
+  const int d1 = sign(cross(c, d, a));
+  const int d2 = sign(cross(c, d, b));
+  const int d3 = sign(cross(a, b, c));
+  const int d4 = sign(cross(a, b, d));
+  if (d1 * d2 < 0 && d3 * d4 < 0)
+  {
+    return true;
+  }
+  return (d1 == 0 && inRange(c, d, a)) || (d2 == 0 && inRange(c, d, b)) || (d3 == 0 && inRange(a, b, c)) || (d4 == 0 && inRange(a, b, d));
+}
+
+bool kiselev::isInside(const Point& point, const Polygon& polygon)
+{
+  const auto& points = polygon.points;
+  RayCrossing crossing{ point };
+  const int closing = crossing(points.back(), points.front());
+  const int crossings = std::inner_product(points.begin(), points.end() - 1, points.begin() + 1, closing, std::plus< int >(), crossing);
+  return crossings % 2 == 1;
+}
+
+bool kiselev::intersects(const Polygon& lhs, const Polygon& rhs)
+{
+  using namespace std::placeholders;
+  const auto& points = lhs.points;
+  auto hits = std::bind(edgeHitsPolygon, _1, _2, std::cref(rhs));
+  if (std::adjacent_find(points.begin(), points.end(), hits) != points.end() || hits(points.back(), points.front()))
+  {
+    return true;
+  }
+  return isInside(lhs.points.front(), rhs) || isInside(rhs.points.front(), lhs);
+}
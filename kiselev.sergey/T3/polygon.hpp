@@ -21,6 +21,9 @@ namespace kiselev
   std::istream& operator>>(std::istream&, Polygon&);
   double getArea(const Polygon&);
   bool isRect(const Polygon&);
+  bool segmentsIntersect(const Point&, const Point&, const Point&, const Point&);
+  bool isInside(const Point&, const Polygon&);
+  bool intersects(const Polygon&, const Polygon&);
 
 }
 #endif
@@ -0,0 +1,181 @@
+#include "rTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+namespace
+{
+  using kiselev::Box;
+  using kiselev::BoxEntry;
+  using Level = kiselev::RTree::Level;
+  constexpr size_t capacity = kiselev::RTree::nodeCapacity;
+
+  Box pointBox(const Box& box, const kiselev::Point& point)
+  {
+    return Box{ std::min(box.minX, point.x), std::min(box.minY, point.y),
+      std::max(box.maxX, point.x), std::max(box.maxY, point.y) };
+  }
+
+  long long centerX(const BoxEntry& entry)
+  {
+    return static_cast< long long >(entry.box.minX) + entry.box.maxX;
+  }
+
+  long long centerY(const BoxEntry& entry)
+  {
+    return static_cast< long long >(entry.box.minY) + entry.box.maxY;
+  }
+
+  bool lessCenterX(const BoxEntry& lhs, const BoxEntry& rhs)
+  {
+    return centerX(lhs) < centerX(rhs);
+  }
+
+  bool lessCenterY(const BoxEntry& lhs, const BoxEntry& rhs)
+  {
+    return centerY(lhs) < centerY(rhs);
+  }
+
+  Box uniteEntry(const Box& box, const BoxEntry& entry)
+  {
+    return kiselev::unite(box, entry.box);
+  }
+
+  size_t groupCount(size_t size)
+  {
+    return (size + capacity - 1) / capacity;
+  }
+
+  struct LeafMaker
+  {
+    const std::vector< kiselev::Polygon >& polygons;
+    BoxEntry operator()(size_t index) const
+    {
+      return BoxEntry{ kiselev::getBox(polygons[index]), index };
+    }
+  };
+
+  struct SliceSorter
+  {
+    Level& level;
+    size_t sliceSize;
+    void operator()(size_t slice) const
+    {
+      auto first = level.begin() + std::min(slice * sliceSize, level.size());
+      auto last = level.begin() + std::min((slice + 1) * sliceSize, level.size());
+      std::sort(first, last, lessCenterY);
+    }
+  };
+
+  struct ParentMaker
+  {
+    const Level& level;
+    BoxEntry operator()(size_t group) const
+    {
+      auto first = level.begin() + group * capacity;
+      auto last = level.begin() + std::min((group + 1) * capacity, level.size());
+      return BoxEntry{ std::accumulate(std::next(first), last, first->box, uniteEntry), group };
+    }
+  };
+
+  Level pack(Level level)
+  {
+    const size_t slices = std::ceil(std::sqrt(static_cast< double >(groupCount(level.size()))));
+    const size_t sliceSize = std::max< size_t >(slices, 1) * capacity;
+    std::sort(level.begin(), level.end(), lessCenterX);
+    std::vector< size_t > sliceIndexes((level.size() + sliceSize - 1) / sliceSize);
+    std::iota(sliceIndexes.begin(), sliceIndexes.end(), 0);
+    std::for_each(sliceIndexes.begin(), sliceIndexes.end(), SliceSorter{ level, sliceSize });
+    return level;
+  }
+
+  Level makeParents(const Level& level)
+  {
+    std::vector< size_t > groups(groupCount(level.size()));
+    std::iota(groups.begin(), groups.end(), 0);
+    Level parents;
+    parents.reserve(groups.size());
+    std::transform(groups.begin(), groups.end(), std::back_inserter(parents), ParentMaker{ level });
+    return parents;
+  }
+
+  void search(const std::vector< Level >&, size_t, size_t, const Box&, std::vector< size_t >&);
+
+  struct EntryVisitor
+  {
+    const std::vector< Level >& levels;
+    size_t level;
+    const Box& box;
+    std::vector< size_t >& result;
+    void operator()(const BoxEntry& entry) const
+    {
+      if (!kiselev::overlaps(entry.box, box))
+      {
+        return;
+      }
+      if (level == 0)
+      {
+        result.push_back(entry.child);
+        return;
+      }
+      search(levels, level - 1, entry.child, box, result);
+    }
+  };
+
+  void search(const std::vector< Level >& levels, size_t level, size_t group, const Box& box,
+    std::vector< size_t >& result)
+  {
+    const Level& entries = levels[level];
+    auto first = entries.begin() + std::min(group * capacity, entries.size());
+    auto last = entries.begin() + std::min((group + 1) * capacity, entries.size());
+    std::for_each(first, last, EntryVisitor{ levels, level, box, result });
+  }
+}
+
+constexpr size_t kiselev::RTree::nodeCapacity;
+
+kiselev::Box kiselev::getBox(const Polygon& polygon)
+{
+  const Point& first = polygon.points.front();
+  const Box init{ first.x, first.y, first.x, first.y };
+  return std::accumulate(polygon.points.begin(), polygon.points.end(), init, pointBox);
+}
+
+kiselev::Box kiselev::unite(const Box& lhs, const Box& rhs)
+{
+  return Box{ std::min(lhs.minX, rhs.minX), std::min(lhs.minY, rhs.minY),
+    std::max(lhs.maxX, rhs.maxX), std::max(lhs.maxY, rhs.maxY) };
+}
+
+bool kiselev::overlaps(const Box& lhs, const Box& rhs)
+{
+  return lhs.minX <= rhs.maxX && rhs.minX <= lhs.maxX && lhs.minY <= rhs.maxY && rhs.minY <= lhs.maxY;
+}
+
+kiselev::RTree::RTree(const std::vector< Polygon >& polygons)
+{
+  std::vector< size_t > indexes(polygons.size());
+  std::iota(indexes.begin(), indexes.end(), 0);
+  Level leaves;
+  leaves.reserve(polygons.size());
+  std::transform(indexes.begin(), indexes.end(), std::back_inserter(leaves), LeafMaker{ polygons });
+  build(std::move(leaves));
+}
+
+void kiselev::RTree::build(Level level)
+{
+  levels_.push_back(pack(std::move(level)));
+  if (levels_.back().size() > nodeCapacity)
+  {
+    build(makeParents(levels_.back()));
+  }
+}
+
+std::vector< size_t > kiselev::RTree::query(const Box& box) const
+{
+  std::vector< size_t > result;
+  search(levels_, levels_.size() - 1, 0, box, result);
+  return result;
+}
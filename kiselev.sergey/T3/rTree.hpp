@@ -0,0 +1,40 @@
+#ifndef RTREE_HPP
+#define RTREE_HPP
+#include <cstddef>
+#include <vector>
+#include "polygon.hpp"
+
+namespace kiselev
+{
+  struct Box
+  {
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+  };
+
+  struct BoxEntry
+  {
+    Box box;
+    size_t child;
+  };
+
+  Box getBox(const Polygon&);
+  Box unite(const Box&, const Box&);
+  bool overlaps(const Box&, const Box&);
+
+  class RTree
+  {
+  public:
+    static constexpr size_t nodeCapacity = 16;
+    using Level = std::vector< BoxEntry >;
+
+    explicit RTree(const std::vector< Polygon >&);
+    std::vector< size_t > query(const Box&) const;
+  private:
+    std::vector< Level > levels_;
+    void build(Level);
+  };
+}
+#endif
@@ -1,10 +1,11 @@
 #ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_COMMAND_PROCESSOR_HPP
 #define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_COMMAND_PROCESSOR_HPP
 
-#include "polygon.hpp"
+#include <iosfwd>
+#include "polygon-store.hpp"
 
 namespace kizhin {
-  void processCommands(PolygonContainer&, std::istream&, std::ostream&);
+  void processCommands(const PolygonStore&, std::istream&, std::ostream&);
 }
 
 #endif
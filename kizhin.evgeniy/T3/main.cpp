@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -19,13 +20,15 @@ int main(int argc, char** argv)
     }
     using namespace kizhin;
     using InIt = std::istream_iterator< Polygon >;
-    PolygonContainer polygons(InIt{ in }, InIt{});
+    PolygonStore polygons;
+    std::copy(InIt{ in }, InIt{}, std::back_inserter(polygons));
     constexpr auto maxSize = std::numeric_limits< std::streamsize >::max();
     while (!in.eof()) {
       in.clear();
       in.ignore(maxSize, '\n');
-      polygons.insert(polygons.end(), InIt{ in }, InIt{});
+      std::copy(InIt{ in }, InIt{}, std::back_inserter(polygons));
     }
+    std::ios_base::sync_with_stdio(false);
     processCommands(polygons, std::cin, std::cout);
   } catch (const std::exception& e) {
     std::cerr << e.what() << '\n';
@@ -0,0 +1,185 @@
+#include "polygon-store.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+namespace kizhin {
+  struct PointDeterminant
+  {
+    std::int64_t operator()(const Point&, const Point&) const noexcept;
+  };
+
+  struct FingerprintCombiner
+  {
+    std::size_t operator()(std::size_t, const Point&) const noexcept;
+  };
+
+  struct SequenceMatch
+  {
+    const PolygonStore& store;
+    PointIt begin;
+    PointIt end;
+    bool operator()(const SequenceIndex::value_type&) const;
+  };
+}
+
+std::int64_t kizhin::PointDeterminant::operator()(const Point& lhs,
+    const Point& rhs) const noexcept
+{
+  const std::int64_t lx = lhs.x;
+  const std::int64_t ly = lhs.y;
+  return lx * rhs.y - ly * rhs.x;
+}
+
+std::size_t kizhin::FingerprintCombiner::operator()(std::size_t seed,
+    const Point& point) const noexcept
+{
+  const std::hash< int > hash{};
+  seed ^= hash(point.x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= hash(point.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+bool kizhin::SequenceMatch::operator()(const SequenceIndex::value_type& value) const
+{
+  const std::size_t polygon = value.second.polygon;
+  return std::equal(store.pointsBegin(polygon), store.pointsEnd(polygon), begin, end);
+}
+
+std::int64_t kizhin::computeDoubledArea(PointIt begin, PointIt end)
+{
+  if (std::distance(begin, end) < 3) {
+    return 0;
+  }
+  const PointDeterminant det{};
+  const auto last = std::prev(end);
+  std::int64_t area = std::inner_product(begin, last, std::next(begin),
+      std::int64_t{ 0 }, std::plus<>{}, det);
+  area += det(*last, *begin);
+  return std::abs(area);
+}
+
+std::size_t kizhin::computeFingerprint(PointIt begin, PointIt end)
+{
+  const std::size_t seed = std::distance(begin, end);
+  return std::accumulate(begin, end, seed, FingerprintCombiner{});
+}
+
+kizhin::PolygonStore::PolygonStore():
+  offsets_(1, 0),
+  hasSequences_(false),
+  tailRun_(0),
+  tailFingerprint_(0)
+{}
+
+void kizhin::PolygonStore::push_back(const Polygon& polygon)
+{
+  const std::size_t vertexCount = polygon.points.size();
+  const auto begin = polygon.points.begin();
+  const auto end = polygon.points.end();
+  points_.insert(points_.end(), begin, end);
+  offsets_.push_back(points_.size());
+  vertexes_.push_back(vertexCount);
+  doubledAreas_.push_back(computeDoubledArea(begin, end));
+  parities_.push_back(vertexCount % 2);
+  if (hasSequences_) {
+    appendSequence(size() - 1);
+  }
+}
+
+std::size_t kizhin::PolygonStore::size() const noexcept
+{
+  return vertexes_.size();
+}
+
+bool kizhin::PolygonStore::empty() const noexcept
+{
+  return vertexes_.empty();
+}
+
+const kizhin::PointContainer& kizhin::PolygonStore::points() const noexcept
+{
+  return points_;
+}
+
+const kizhin::OffsetContainer& kizhin::PolygonStore::offsets() const noexcept
+{
+  return offsets_;
+}
+
+const kizhin::SizeContainer& kizhin::PolygonStore::vertexes() const noexcept
+{
+  return vertexes_;
+}
+
+const kizhin::AreaContainer& kizhin::PolygonStore::doubledAreas() const noexcept
+{
+  return doubledAreas_;
+}
+
+const kizhin::ParityContainer& kizhin::PolygonStore::parities() const noexcept
+{
+  return parities_;
+}
+
+kizhin::PointIt kizhin::PolygonStore::pointsBegin(std::size_t polygon) const noexcept
+{
+  return points_.begin() + offsets_[polygon];
+}
+
+kizhin::PointIt kizhin::PolygonStore::pointsEnd(std::size_t polygon) const noexcept
+{
+  return points_.begin() + offsets_[polygon + 1];
+}
+
+std::size_t kizhin::PolygonStore::maxSequence(const Polygon& polygon) const
+{
+  if (!hasSequences_) {
+    buildSequences();
+  }
+  const PointIt begin = polygon.points.begin();
+  const PointIt end = polygon.points.end();
+  const auto found = findSequence(computeFingerprint(begin, end), begin, end);
+  return found == sequences_.end() ? 0 : found->second.maxRun;
+}
+
+kizhin::SequenceIndex::iterator kizhin::PolygonStore::findSequence(std::size_t fingerprint,
+    PointIt begin, PointIt end) const
+{
+  const auto range = sequences_.equal_range(fingerprint);
+  const auto found = std::find_if(range.first, range.second, SequenceMatch{ *this, begin, end });
+  return found == range.second ? sequences_.end() : found;
+}
+
+void kizhin::PolygonStore::buildSequences() const
+{
+  sequences_.clear();
+  tailRun_ = 0;
+  std::vector< std::size_t > polygons(size());
+  std::iota(polygons.begin(), polygons.end(), 0);
+  using namespace std::placeholders;
+  std::for_each(polygons.begin(), polygons.end(),
+      std::bind(&PolygonStore::appendSequence, this, _1));
+  hasSequences_ = true;
+}
+
+void kizhin::PolygonStore::appendSequence(std::size_t polygon) const
+{
+  const PointIt begin = pointsBegin(polygon);
+  const PointIt end = pointsEnd(polygon);
+  const bool continues = tailRun_ != 0 &&
+      std::equal(pointsBegin(polygon - 1), pointsEnd(polygon - 1), begin, end);
+  if (continues) {
+    ++tailRun_;
+  } else {
+    tailRun_ = 1;
+    tailFingerprint_ = computeFingerprint(begin, end);
+  }
+  auto found = findSequence(tailFingerprint_, begin, end);
+  if (found == sequences_.end()) {
+    found = sequences_.emplace(tailFingerprint_, SequenceEntry{ polygon, 0 });
+  }
+  found->second.maxRun = std::max(found->second.maxRun, tailRun_);
+}
@@ -0,0 +1,69 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_POLYGON_STORE_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_POLYGON_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "polygon.hpp"
+
+namespace kizhin {
+  class PolygonStore;
+  struct SequenceEntry;
+
+  using OffsetContainer = std::vector< std::size_t >;
+  using SizeContainer = std::vector< std::size_t >;
+  using AreaContainer = std::vector< std::int64_t >;
+  using ParityContainer = std::vector< unsigned char >;
+  using SequenceIndex = std::unordered_multimap< std::size_t, SequenceEntry >;
+  using PointIt = PointContainer::const_iterator;
+
+  std::int64_t computeDoubledArea(PointIt, PointIt);
+  std::size_t computeFingerprint(PointIt, PointIt);
+}
+
+struct kizhin::SequenceEntry
+{
+  std::size_t polygon;
+  std::size_t maxRun;
+};
+
+class kizhin::PolygonStore
+{
+public:
+  using value_type = Polygon;
+
+  PolygonStore();
+
+  void push_back(const Polygon&);
+
+  std::size_t size() const noexcept;
+  bool empty() const noexcept;
+
+  const PointContainer& points() const noexcept;
+  const OffsetContainer& offsets() const noexcept;
+  const SizeContainer& vertexes() const noexcept;
+  const AreaContainer& doubledAreas() const noexcept;
+  const ParityContainer& parities() const noexcept;
+
+  PointIt pointsBegin(std::size_t) const noexcept;
+  PointIt pointsEnd(std::size_t) const noexcept;
+  std::size_t maxSequence(const Polygon&) const;
+
+private:
+  PointContainer points_;
+  OffsetContainer offsets_;
+  SizeContainer vertexes_;
+  AreaContainer doubledAreas_;
+  ParityContainer parities_;
+  mutable SequenceIndex sequences_;
+  mutable bool hasSequences_;
+  mutable std::size_t tailRun_;
+  mutable std::size_t tailFingerprint_;
+
+  SequenceIndex::iterator findSequence(std::size_t, PointIt, PointIt) const;
+  void buildSequences() const;
+  void appendSequence(std::size_t) const;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "query-batch.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <limits>
+
+namespace kizhin {
+  struct ScanAccumulator
+  {
+    ScanSummary& summary;
+    AreaContainer::const_iterator area;
+    ParityContainer::const_iterator parity;
+    void operator()(std::size_t);
+  };
+}
+
+kizhin::ScanSummary::ScanSummary():
+  evenCount(0),
+  oddCount(0),
+  evenArea(0),
+  oddArea(0),
+  minArea(std::numeric_limits< std::int64_t >::max()),
+  maxArea(std::numeric_limits< std::int64_t >::min()),
+  minVertexes(std::numeric_limits< std::size_t >::max()),
+  maxVertexes(0),
+  byVertexes()
+{}
+
+void kizhin::ScanAccumulator::operator()(std::size_t vertexes)
+{
+  const std::int64_t doubledArea = *area++;
+  if (*parity++ == 0) {
+    ++summary.evenCount;
+    summary.evenArea += doubledArea;
+  } else {
+    ++summary.oddCount;
+    summary.oddArea += doubledArea;
+  }
+  summary.minArea = std::min(summary.minArea, doubledArea);
+  summary.maxArea = std::max(summary.maxArea, doubledArea);
+  summary.minVertexes = std::min(summary.minVertexes, vertexes);
+  summary.maxVertexes = std::max(summary.maxVertexes, vertexes);
+  if (summary.byVertexes.empty()) {
+    return;
+  }
+  const auto stats = summary.byVertexes.find(vertexes);
+  if (stats != summary.byVertexes.end()) {
+    ++stats->second.count;
+    stats->second.doubledArea += doubledArea;
+  }
+}
+
+void kizhin::scanPolygons(const PolygonStore& polygons, ScanSummary& summary)
+{
+  const SizeContainer& vertexes = polygons.vertexes();
+  const ScanAccumulator accumulator{ summary, polygons.doubledAreas().begin(),
+      polygons.parities().begin() };
+  std::for_each(vertexes.begin(), vertexes.end(), accumulator);
+}
+
+bool kizhin::hasBufferedInput(std::istream& in)
+{
+  std::streambuf* buffer = in.rdbuf();
+  while (buffer->in_avail() > 0 && std::isspace(buffer->sgetc())) {
+    buffer->sbumpc();
+  }
+  return buffer->in_avail() > 0;
+}
+
+constexpr std::size_t kizhin::QueryBatch::maxSize;
+
+kizhin::QueryBatch::QueryBatch(const PolygonStore& polygons):
+  polygons_(polygons),
+  queries_(),
+  summary_(),
+  needsScan_(false)
+{}
+
+void kizhin::QueryBatch::push(const Query& query)
+{
+  queries_.push_back(query);
+}
+
+void kizhin::QueryBatch::pushAggregate(const Query& query)
+{
+  needsScan_ = true;
+  queries_.push_back(query);
+}
+
+void kizhin::QueryBatch::requestVertexCount(std::size_t count)
+{
+  summary_.byVertexes.emplace(count, VertexStats{ 0, 0 });
+}
+
+std::size_t kizhin::QueryBatch::size() const noexcept
+{
+  return queries_.size();
+}
+
+bool kizhin::QueryBatch::full() const noexcept
+{
+  return queries_.size() >= maxSize;
+}
+
+void kizhin::QueryBatch::flush(std::ostream& out)
+{
+  using namespace std::placeholders;
+  if (needsScan_) {
+    scanPolygons(polygons_, summary_);
+  }
+  std::for_each(queries_.begin(), queries_.end(),
+      std::bind(&Query::operator(), _1, std::cref(summary_), std::ref(out)));
+  queries_.clear();
+  summary_ = ScanSummary{};
+  needsScan_ = false;
+}
@@ -0,0 +1,67 @@
+#ifndef SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_QUERY_BATCH_HPP
+#define SPBSPU_LABS_2025_TP_A_KIZHIN_EVGENIY_T3_QUERY_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <vector>
+#include "polygon-store.hpp"
+
+namespace kizhin {
+  struct VertexStats;
+  struct ScanSummary;
+  class QueryBatch;
+
+  using Query = std::function< void(const ScanSummary&, std::ostream&) >;
+  using VertexStatsContainer = std::map< std::size_t, VertexStats >;
+
+  void scanPolygons(const PolygonStore&, ScanSummary&);
+  bool hasBufferedInput(std::istream&);
+}
+
+struct kizhin::VertexStats
+{
+  std::size_t count;
+  std::int64_t doubledArea;
+};
+
+struct kizhin::ScanSummary
+{
+  ScanSummary();
+
+  std::size_t evenCount;
+  std::size_t oddCount;
+  std::int64_t evenArea;
+  std::int64_t oddArea;
+  std::int64_t minArea;
+  std::int64_t maxArea;
+  std::size_t minVertexes;
+  std::size_t maxVertexes;
+  VertexStatsContainer byVertexes;
+};
+
+class kizhin::QueryBatch
+{
+public:
+  static constexpr std::size_t maxSize = 1024;
+
+  explicit QueryBatch(const PolygonStore&);
+
+  void push(const Query&);
+  void pushAggregate(const Query&);
+  void requestVertexCount(std::size_t);
+
+  std::size_t size() const noexcept;
+  bool full() const noexcept;
+  void flush(std::ostream&);
+
+private:
+  const PolygonStore& polygons_;
+  std::vector< Query > queries_;
+  ScanSummary summary_;
+  bool needsScan_;
+};
+
+#endif
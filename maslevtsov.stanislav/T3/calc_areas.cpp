@@ -7,52 +7,57 @@
 #include "polygon_utils.hpp"
 
 namespace {
-  double calc_areas_sum(const std::vector< maslevtsov::Polygon >& polygons)
+  long long get_even_doubled_area(const maslevtsov::Polygon& polygon)
   {
-    using namespace maslevtsov;
+    return maslevtsov::is_even_vertex_num(polygon) ? maslevtsov::get_doubled_area(polygon) : 0;
+  }
 
-    std::vector< double > to_accumulate;
-    std::transform(polygons.cbegin(), polygons.cend(), std::back_inserter(to_accumulate), get_polygon_area);
-    double result = std::accumulate(to_accumulate.cbegin(), to_accumulate.cend(), 0.0);
-    return result;
+  long long get_odd_doubled_area(const maslevtsov::Polygon& polygon)
+  {
+    return maslevtsov::is_odd_vertex_num(polygon) ? maslevtsov::get_doubled_area(polygon) : 0;
   }
 
-  double get_even_area(const std::vector< maslevtsov::Polygon >& polygons)
+  long long get_same_vertex_num_doubled_area(std::size_t vertex_num, const maslevtsov::Polygon& polygon)
   {
-    using namespace maslevtsov;
+    return maslevtsov::is_equal_vertex_num(vertex_num, polygon) ? maslevtsov::get_doubled_area(polygon) : 0;
+  }
 
-    std::vector< Polygon > filtered;
-    std::copy_if(polygons.cbegin(), polygons.cend(), std::back_inserter(filtered), is_even_vertex_num);
-    return calc_areas_sum(filtered);
+  template< class Map >
+  double calc_areas_sum(const std::vector< maslevtsov::Polygon >& polygons, const maslevtsov::ParallelReducer& reducer,
+    Map map)
+  {
+    return reducer.map_reduce(polygons, 0LL, map, std::plus< long long >()) / 2.0;
   }
 
-  double get_odd_area(const std::vector< maslevtsov::Polygon >& polygons)
+  double get_even_area(const std::vector< maslevtsov::Polygon >& polygons, const maslevtsov::ParallelReducer& reducer)
   {
-    using namespace maslevtsov;
+    return calc_areas_sum(polygons, reducer, get_even_doubled_area);
+  }
 
-    std::vector< Polygon > filtered;
-    std::copy_if(polygons.cbegin(), polygons.cend(), std::back_inserter(filtered), is_odd_vertex_num);
-    return calc_areas_sum(filtered);
+  double get_odd_area(const std::vector< maslevtsov::Polygon >& polygons, const maslevtsov::ParallelReducer& reducer)
+  {
+    return calc_areas_sum(polygons, reducer, get_odd_doubled_area);
   }
 
-  double get_mean_area(const std::vector< maslevtsov::Polygon >& polygons)
+  double get_mean_area(const std::vector< maslevtsov::Polygon >& polygons, const maslevtsov::ParallelReducer& reducer)
   {
     using namespace maslevtsov;
 
     if (polygons.empty()) {
       throw std::invalid_argument("no polygons");
     }
-    return calc_areas_sum(polygons) / polygons.size();
+    return calc_areas_sum(polygons, reducer, get_doubled_area) / polygons.size();
   }
 }
 
-void maslevtsov::calc_areas(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::calc_areas(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+  std::ostream& out)
 {
   std::map< std::string, std::function< double() > > subcommands;
   using namespace std::placeholders;
-  subcommands["EVEN"] = std::bind(get_even_area, std::cref(polygons));
-  subcommands["ODD"] = std::bind(get_odd_area, std::cref(polygons));
-  subcommands["MEAN"] = std::bind(get_mean_area, std::cref(polygons));
+  subcommands["EVEN"] = std::bind(get_even_area, std::cref(polygons), std::cref(reducer));
+  subcommands["ODD"] = std::bind(get_odd_area, std::cref(polygons), std::cref(reducer));
+  subcommands["MEAN"] = std::bind(get_mean_area, std::cref(polygons), std::cref(reducer));
 
   std::string subcommand;
   in >> subcommand;
@@ -64,10 +69,8 @@ void maslevtsov::calc_areas(const std::vector< Polygon >& polygons, std::istream
     if (vertex_num < 3) {
       throw std::invalid_argument("invalid polygon");
     }
-    std::vector< Polygon > filtered;
-    auto same_vertex_num = std::bind(is_equal_vertex_num, vertex_num, std::placeholders::_1);
-    std::copy_if(polygons.cbegin(), polygons.cend(), std::back_inserter(filtered), same_vertex_num);
-    result = calc_areas_sum(filtered);
+    auto same_vertex_num_area = std::bind(get_same_vertex_num_doubled_area, vertex_num, std::placeholders::_1);
+    result = calc_areas_sum(polygons, reducer, same_vertex_num_area);
   }
   IOFmtGuard guard(out);
   out << std::fixed << std::setprecision(1) << result;
@@ -2,9 +2,11 @@
 #define CALC_AREAS_HPP
 
 #include "shapes.hpp"
+#include "parallel_reducer.hpp"
 
 namespace maslevtsov {
-  void calc_areas(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
+  void calc_areas(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+    std::ostream& out);
 }
 
 #endif
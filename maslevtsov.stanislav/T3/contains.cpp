@@ -0,0 +1,11 @@
+#include "contains.hpp"
+#include <stdexcept>
+
+void maslevtsov::count_containing(GridIndex& index, std::istream& in, std::ostream& out)
+{
+  Point point{0, 0};
+  if (!(in >> point)) {
+    throw std::invalid_argument("invalid point");
+  }
+  out << index.count(point);
+}
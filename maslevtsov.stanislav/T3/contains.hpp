@@ -0,0 +1,10 @@
+#ifndef CONTAINS_HPP
+#define CONTAINS_HPP
+
+#include "grid_index.hpp"
+
+namespace maslevtsov {
+  void count_containing(GridIndex& index, std::istream& in, std::ostream& out);
+}
+
+#endif
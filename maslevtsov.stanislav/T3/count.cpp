@@ -5,23 +5,33 @@
 #include "polygon_utils.hpp"
 
 namespace {
-  std::size_t count_even_vertexes(const std::vector< maslevtsov::Polygon >& polygons)
+  template< class Predicate >
+  std::size_t count_if(const std::vector< maslevtsov::Polygon >& polygons, const maslevtsov::ParallelReducer& reducer,
+    Predicate predicate)
   {
-    return std::count_if(polygons.cbegin(), polygons.cend(), maslevtsov::is_even_vertex_num);
+    return reducer.map_reduce(polygons, std::size_t(0), predicate, std::plus< std::size_t >());
   }
 
-  std::size_t count_odd_vertexes(const std::vector< maslevtsov::Polygon >& polygons)
+  std::size_t count_even_vertexes(const std::vector< maslevtsov::Polygon >& polygons,
+    const maslevtsov::ParallelReducer& reducer)
   {
-    return std::count_if(polygons.cbegin(), polygons.cend(), maslevtsov::is_odd_vertex_num);
+    return count_if(polygons, reducer, maslevtsov::is_even_vertex_num);
+  }
+
+  std::size_t count_odd_vertexes(const std::vector< maslevtsov::Polygon >& polygons,
+    const maslevtsov::ParallelReducer& reducer)
+  {
+    return count_if(polygons, reducer, maslevtsov::is_odd_vertex_num);
   }
 }
 
-void maslevtsov::count_vertexes(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::count_vertexes(const std::vector< Polygon >& polygons, const ParallelReducer& reducer,
+  std::istream& in, std::ostream& out)
 {
   std::map< std::string, std::function< std::size_t() > > subcommands;
   using namespace std::placeholders;
-  subcommands["EVEN"] = std::bind(count_even_vertexes, std::cref(polygons));
-  subcommands["ODD"] = std::bind(count_odd_vertexes, std::cref(polygons));
+  subcommands["EVEN"] = std::bind(count_even_vertexes, std::cref(polygons), std::cref(reducer));
+  subcommands["ODD"] = std::bind(count_odd_vertexes, std::cref(polygons), std::cref(reducer));
 
   std::string subcommand;
   in >> subcommand;
@@ -33,6 +43,6 @@ void maslevtsov::count_vertexes(const std::vector< Polygon >& polygons, std::ist
       throw std::invalid_argument("invalid polygon");
     }
     auto same_vertex_num = std::bind(is_equal_vertex_num, vertex_num, std::placeholders::_1);
-    out << std::count_if(polygons.cbegin(), polygons.cend(), same_vertex_num);
+    out << count_if(polygons, reducer, same_vertex_num);
   }
 }
@@ -2,9 +2,11 @@
 #define COUNT_HPP
 
 #include "shapes.hpp"
+#include "parallel_reducer.hpp"
 
 namespace maslevtsov {
-  void count_vertexes(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
+  void count_vertexes(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+    std::ostream& out);
 }
 
 #endif
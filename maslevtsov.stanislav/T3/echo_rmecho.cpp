@@ -3,7 +3,7 @@
 #include <algorithm>
 #include "polygon_utils.hpp"
 
-void maslevtsov::echo(std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::echo(std::vector< Polygon >& polygons, std::size_t& version, std::istream& in, std::ostream& out)
 {
   Polygon polygon;
   if (!(in >> polygon)) {
@@ -16,10 +16,12 @@ void maslevtsov::echo(std::vector< Polygon >& polygons, std::istream& in, std::o
   auto inserter = std::bind(WithSamesInserter{with_echoes}, std::placeholders::_1, polygon);
   std::transform(polygons.begin(), polygons.end(), dump.begin(), inserter);
   polygons = with_echoes;
+  ++version;
   out << additional_size;
 }
 
-void maslevtsov::remove_echo(std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::remove_echo(std::vector< Polygon >& polygons, std::size_t& version, std::istream& in,
+  std::ostream& out)
 {
   Polygon polygon;
   if (!(in >> polygon)) {
@@ -32,4 +34,5 @@ void maslevtsov::remove_echo(std::vector< Polygon >& polygons, std::istream& in,
   auto first_to_erase = std::unique(polygons.begin(), polygons.end(), is_same_both_to_arg);
   out << std::distance(first_to_erase, polygons.end());
   polygons.erase(first_to_erase, polygons.end());
+  ++version;
 }
@@ -4,8 +4,8 @@
 #include "shapes.hpp"
 
 namespace maslevtsov {
-  void echo(std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
-  void remove_echo(std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
+  void echo(std::vector< Polygon >& polygons, std::size_t& version, std::istream& in, std::ostream& out);
+  void remove_echo(std::vector< Polygon >& polygons, std::size_t& version, std::istream& in, std::ostream& out);
 }
 
 #endif
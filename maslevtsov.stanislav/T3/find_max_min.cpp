@@ -1,39 +1,62 @@
 #include "find_max_min.hpp"
 #include <functional>
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <io_fmt_guard.hpp>
 #include "polygon_utils.hpp"
 
 namespace {
-  void print_max_area(const std::vector< maslevtsov::Polygon >& polygons, std::ostream& out)
+  using reducer_t = maslevtsov::ParallelReducer;
+
+  std::size_t get_vertex_num(const maslevtsov::Polygon& polygon)
+  {
+    return polygon.points.size();
+  }
+
+  template< class T >
+  T get_max(T lhs, T rhs)
+  {
+    return std::max(lhs, rhs);
+  }
+
+  template< class T >
+  T get_min(T lhs, T rhs)
+  {
+    return std::min(lhs, rhs);
+  }
+
+  void print_max_area(const std::vector< maslevtsov::Polygon >& polygons, const reducer_t& reducer, std::ostream& out)
   {
-    std::vector< double > areas;
-    std::transform(polygons.cbegin(), polygons.cend(), std::back_inserter(areas), maslevtsov::get_polygon_area);
+    double result = reducer.map_reduce(polygons, 0.0, maslevtsov::get_polygon_area, get_max< double >);
     maslevtsov::IOFmtGuard guard(out);
-    out << std::fixed << std::setprecision(1) << *std::max_element(areas.cbegin(), areas.cend());
+    out << std::fixed << std::setprecision(1) << result;
   }
 
-  void print_max_vertexes(const std::vector< maslevtsov::Polygon >& polygons, std::ostream& out)
+  void print_max_vertexes(const std::vector< maslevtsov::Polygon >& polygons, const reducer_t& reducer,
+    std::ostream& out)
   {
-    out << std::max_element(polygons.cbegin(), polygons.cend(), maslevtsov::compare_vertex_num_less)->points.size();
+    out << reducer.map_reduce(polygons, std::size_t(0), get_vertex_num, get_max< std::size_t >);
   }
 
-  void print_min_area(const std::vector< maslevtsov::Polygon >& polygons, std::ostream& out)
+  void print_min_area(const std::vector< maslevtsov::Polygon >& polygons, const reducer_t& reducer, std::ostream& out)
   {
-    std::vector< double > areas;
-    std::transform(polygons.cbegin(), polygons.cend(), std::back_inserter(areas), maslevtsov::get_polygon_area);
+    double identity = std::numeric_limits< double >::max();
+    double result = reducer.map_reduce(polygons, identity, maslevtsov::get_polygon_area, get_min< double >);
     maslevtsov::IOFmtGuard guard(out);
-    out << std::fixed << std::setprecision(1) << *std::min_element(areas.cbegin(), areas.cend());
+    out << std::fixed << std::setprecision(1) << result;
   }
 
-  void print_min_vertexes(const std::vector< maslevtsov::Polygon >& polygons, std::ostream& out)
+  void print_min_vertexes(const std::vector< maslevtsov::Polygon >& polygons, const reducer_t& reducer,
+    std::ostream& out)
   {
-    out << std::min_element(polygons.cbegin(), polygons.cend(), maslevtsov::compare_vertex_num_less)->points.size();
+    std::size_t identity = std::numeric_limits< std::size_t >::max();
+    out << reducer.map_reduce(polygons, identity, get_vertex_num, get_min< std::size_t >);
   }
 }
 
-void maslevtsov::find_max(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::find_max(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+  std::ostream& out)
 {
   if (polygons.empty()) {
     throw std::invalid_argument("no polygons");
@@ -41,23 +64,24 @@ void maslevtsov::find_max(const std::vector< Polygon >& polygons, std::istream&
 
   std::map< std::string, std::function< void(std::ostream&) > > subcommands;
   using namespace std::placeholders;
-  subcommands["AREA"] = std::bind(print_max_area, std::cref(polygons), _1);
-  subcommands["VERTEXES"] = std::bind(print_max_vertexes, std::cref(polygons), _1);
+  subcommands["AREA"] = std::bind(print_max_area, std::cref(polygons), std::cref(reducer), _1);
+  subcommands["VERTEXES"] = std::bind(print_max_vertexes, std::cref(polygons), std::cref(reducer), _1);
 
   std::string subcommand;
   in >> subcommand;
   subcommands.at(subcommand)(out);
 }
 
-void maslevtsov::find_min(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out)
+void maslevtsov::find_min(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+  std::ostream& out)
 {
   if (polygons.empty()) {
     throw std::invalid_argument("no polygons");
   }
   std::map< std::string, std::function< void(std::ostream&) > > subcommands;
   using namespace std::placeholders;
-  subcommands["AREA"] = std::bind(print_min_area, std::cref(polygons), _1);
-  subcommands["VERTEXES"] = std::bind(print_min_vertexes, std::cref(polygons), _1);
+  subcommands["AREA"] = std::bind(print_min_area, std::cref(polygons), std::cref(reducer), _1);
+  subcommands["VERTEXES"] = std::bind(print_min_vertexes, std::cref(polygons), std::cref(reducer), _1);
 
   std::string subcommand;
   in >> subcommand;
@@ -2,10 +2,13 @@
 #define FIND_MAX_MIN_HPP
 
 #include "shapes.hpp"
+#include "parallel_reducer.hpp"
 
 namespace maslevtsov {
-  void find_max(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
-  void find_min(const std::vector< Polygon >& polygons, std::istream& in, std::ostream& out);
+  void find_max(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+    std::ostream& out);
+  void find_min(const std::vector< Polygon >& polygons, const ParallelReducer& reducer, std::istream& in,
+    std::ostream& out);
 }
 
 #endif
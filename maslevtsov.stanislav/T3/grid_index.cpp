@@ -0,0 +1,196 @@
+#include "grid_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include "polygon_utils.hpp"
+
+namespace {
+  struct IndexedBox
+  {
+    std::size_t id;
+    maslevtsov::BoundingBox box;
+  };
+
+  struct CellEntry
+  {
+    std::size_t cell;
+    std::size_t id;
+  };
+
+  struct CellWalker
+  {
+    std::size_t side;
+    std::size_t first_column;
+    std::size_t last_column;
+    std::size_t row;
+    std::size_t column;
+    std::size_t id;
+
+    CellEntry operator()()
+    {
+      CellEntry entry{row * side + column, id};
+      if (column == last_column) {
+        column = first_column;
+        ++row;
+      } else {
+        ++column;
+      }
+      return entry;
+    }
+  };
+
+  struct CellAppender
+  {
+    const maslevtsov::GridGeometry& geometry;
+    std::vector< CellEntry >& cells;
+
+    void operator()(const IndexedBox& indexed)
+    {
+      std::size_t first_column = geometry.column_of(indexed.box.min.x);
+      std::size_t last_column = geometry.column_of(indexed.box.max.x);
+      std::size_t first_row = geometry.row_of(indexed.box.min.y);
+      std::size_t last_row = geometry.row_of(indexed.box.max.y);
+      std::size_t cells_num = (last_column - first_column + 1) * (last_row - first_row + 1);
+      CellWalker walker{geometry.side, first_column, last_column, first_row, first_column, indexed.id};
+      std::generate_n(std::back_inserter(cells), cells_num, walker);
+    }
+  };
+
+  struct CellCounter
+  {
+    std::vector< std::size_t >& offsets;
+
+    void operator()(const CellEntry& entry)
+    {
+      ++offsets[entry.cell + 1];
+    }
+  };
+
+  maslevtsov::BoundingBox extend_box(const maslevtsov::BoundingBox& box, const maslevtsov::Point& point)
+  {
+    maslevtsov::Point min{std::min(box.min.x, point.x), std::min(box.min.y, point.y)};
+    maslevtsov::Point max{std::max(box.max.x, point.x), std::max(box.max.y, point.y)};
+    return {min, max};
+  }
+
+  bool is_degenerate(const std::vector< maslevtsov::Polygon >& polygons, std::size_t id)
+  {
+    return polygons[id].points.size() < 3;
+  }
+
+  IndexedBox index_box(const std::vector< maslevtsov::Polygon >& polygons, std::size_t id)
+  {
+    return {id, maslevtsov::get_bounding_box(polygons[id])};
+  }
+
+  maslevtsov::BoundingBox unite_indexed(const maslevtsov::BoundingBox& lhs, const IndexedBox& rhs)
+  {
+    return maslevtsov::unite_boxes(lhs, rhs.box);
+  }
+
+  bool is_cell_less(const CellEntry& lhs, const CellEntry& rhs)
+  {
+    return lhs.cell < rhs.cell;
+  }
+
+  std::size_t get_entry_id(const CellEntry& entry)
+  {
+    return entry.id;
+  }
+
+  bool contains_indexed(const std::vector< maslevtsov::Polygon >& polygons, std::size_t id,
+    const maslevtsov::Point& point)
+  {
+    return maslevtsov::contains_point(polygons[id], point);
+  }
+}
+
+maslevtsov::BoundingBox maslevtsov::get_bounding_box(const Polygon& polygon)
+{
+  const Point& first = polygon.points.front();
+  return std::accumulate(polygon.points.cbegin(), polygon.points.cend(), BoundingBox{first, first}, extend_box);
+}
+
+maslevtsov::BoundingBox maslevtsov::unite_boxes(const BoundingBox& lhs, const BoundingBox& rhs)
+{
+  return extend_box(extend_box(lhs, rhs.min), rhs.max);
+}
+
+bool maslevtsov::GridGeometry::covers(const Point& point) const noexcept
+{
+  bool in_x_range = bounds.min.x <= point.x && point.x <= bounds.max.x;
+  bool in_y_range = bounds.min.y <= point.y && point.y <= bounds.max.y;
+  return side != 0 && in_x_range && in_y_range;
+}
+
+std::size_t maslevtsov::GridGeometry::column_of(int x) const noexcept
+{
+  return static_cast< std::size_t >((static_cast< long long >(x) - bounds.min.x) / cell_width);
+}
+
+std::size_t maslevtsov::GridGeometry::row_of(int y) const noexcept
+{
+  return static_cast< std::size_t >((static_cast< long long >(y) - bounds.min.y) / cell_height);
+}
+
+maslevtsov::GridIndex::GridIndex(const std::vector< Polygon >& polygons, const std::size_t& version):
+  polygons_(polygons),
+  version_(version),
+  indexed_version_(version),
+  geometry_{{{0, 0}, {0, 0}}, 0, 1, 1},
+  offsets_(),
+  entries_()
+{
+  rebuild();
+}
+
+std::size_t maslevtsov::GridIndex::count(const Point& point)
+{
+  if (version_ != indexed_version_) {
+    rebuild();
+  }
+  if (!geometry_.covers(point)) {
+    return 0;
+  }
+  std::size_t cell = geometry_.row_of(point.y) * geometry_.side + geometry_.column_of(point.x);
+  auto begin_it = entries_.cbegin() + offsets_[cell];
+  auto end_it = entries_.cbegin() + offsets_[cell + 1];
+  using namespace std::placeholders;
+  return std::count_if(begin_it, end_it, std::bind(contains_indexed, std::cref(polygons_), _1, point));
+}
+
+void maslevtsov::GridIndex::rebuild()
+{
+  using namespace std::placeholders;
+  indexed_version_ = version_;
+  geometry_.side = 0;
+  offsets_.assign(1, 0);
+  entries_.clear();
+  std::vector< std::size_t > ids(polygons_.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  ids.erase(std::remove_if(ids.begin(), ids.end(), std::bind(is_degenerate, std::cref(polygons_), _1)), ids.end());
+  if (ids.empty()) {
+    return;
+  }
+  std::vector< IndexedBox > boxes;
+  boxes.reserve(ids.size());
+  std::transform(ids.cbegin(), ids.cend(), std::back_inserter(boxes), std::bind(index_box, std::cref(polygons_), _1));
+  geometry_.bounds = std::accumulate(boxes.cbegin() + 1, boxes.cend(), boxes.front().box, unite_indexed);
+  std::size_t side = static_cast< std::size_t >(std::ceil(std::sqrt(static_cast< double >(boxes.size()))));
+  long long width = static_cast< long long >(geometry_.bounds.max.x) - geometry_.bounds.min.x + 1;
+  long long height = static_cast< long long >(geometry_.bounds.max.y) - geometry_.bounds.min.y + 1;
+  geometry_.side = side;
+  geometry_.cell_width = (width + static_cast< long long >(side) - 1) / static_cast< long long >(side);
+  geometry_.cell_height = (height + static_cast< long long >(side) - 1) / static_cast< long long >(side);
+
+  std::vector< CellEntry > cells;
+  std::for_each(boxes.cbegin(), boxes.cend(), CellAppender{geometry_, cells});
+  std::sort(cells.begin(), cells.end(), is_cell_less);
+  offsets_.assign(side * side + 1, 0);
+  std::for_each(cells.cbegin(), cells.cend(), CellCounter{offsets_});
+  std::partial_sum(offsets_.cbegin(), offsets_.cend(), offsets_.begin());
+  entries_.reserve(cells.size());
+  std::transform(cells.cbegin(), cells.cend(), std::back_inserter(entries_), get_entry_id);
+}
@@ -0,0 +1,46 @@
+#ifndef GRID_INDEX_HPP
+#define GRID_INDEX_HPP
+
+#include "shapes.hpp"
+
+namespace maslevtsov {
+  struct BoundingBox
+  {
+    Point min, max;
+  };
+
+  BoundingBox get_bounding_box(const Polygon& polygon);
+  BoundingBox unite_boxes(const BoundingBox& lhs, const BoundingBox& rhs);
+
+  struct GridGeometry
+  {
+    BoundingBox bounds;
+    std::size_t side;
+    long long cell_width;
+    long long cell_height;
+
+    bool covers(const Point& point) const noexcept;
+    std::size_t column_of(int x) const noexcept;
+    std::size_t row_of(int y) const noexcept;
+  };
+
+  class GridIndex
+  {
+  public:
+    GridIndex(const std::vector< Polygon >& polygons, const std::size_t& version);
+
+    std::size_t count(const Point& point);
+
+  private:
+    const std::vector< Polygon >& polygons_;
+    const std::size_t& version_;
+    std::size_t indexed_version_;
+    GridGeometry geometry_;
+    std::vector< std::size_t > offsets_;
+    std::vector< std::size_t > entries_;
+
+    void rebuild();
+  };
+}
+
+#endif
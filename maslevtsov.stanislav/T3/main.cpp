@@ -8,6 +8,7 @@
 #include "find_max_min.hpp"
 #include "count.hpp"
 #include "echo_rmecho.hpp"
+#include "contains.hpp"
 
 int main(int argc, char** argv)
 {
@@ -22,6 +23,13 @@ int main(int argc, char** argv)
     std::cerr << "<INVALID DATA FILE>\n";
     return 1;
   }
+  ParallelReducer reducer;
+  try {
+    reducer = make_env_reducer();
+  } catch (const std::exception&) {
+    std::cerr << "<INVALID THREADS NUMBER>\n";
+    return 1;
+  }
   std::vector< Polygon > polygons;
   while (!fin.eof()) {
     if (fin.fail()) {
@@ -30,14 +38,17 @@ int main(int argc, char** argv)
     }
     std::copy(std::istream_iterator< Polygon >(fin), std::istream_iterator< Polygon >(), std::back_inserter(polygons));
   }
+  std::size_t polygons_version = 0;
+  GridIndex grid_index(polygons, polygons_version);
   std::map< std::string, std::function< void(std::istream&, std::ostream&) > > commands;
   using namespace std::placeholders;
-  commands["AREA"] = std::bind(calc_areas, std::cref(polygons), _1, _2);
-  commands["MAX"] = std::bind(find_max, std::cref(polygons), _1, _2);
-  commands["MIN"] = std::bind(find_min, std::cref(polygons), _1, _2);
-  commands["COUNT"] = std::bind(count_vertexes, std::cref(polygons), _1, _2);
-  commands["ECHO"] = std::bind(echo, std::ref(polygons), _1, _2);
-  commands["RMECHO"] = std::bind(remove_echo, std::ref(polygons), _1, _2);
+  commands["AREA"] = std::bind(calc_areas, std::cref(polygons), std::cref(reducer), _1, _2);
+  commands["MAX"] = std::bind(find_max, std::cref(polygons), std::cref(reducer), _1, _2);
+  commands["MIN"] = std::bind(find_min, std::cref(polygons), std::cref(reducer), _1, _2);
+  commands["COUNT"] = std::bind(count_vertexes, std::cref(polygons), std::cref(reducer), _1, _2);
+  commands["ECHO"] = std::bind(echo, std::ref(polygons), std::ref(polygons_version), _1, _2);
+  commands["RMECHO"] = std::bind(remove_echo, std::ref(polygons), std::ref(polygons_version), _1, _2);
+  commands["CONTAINS"] = std::bind(count_containing, std::ref(grid_index), _1, _2);
   std::string command;
   while (!(std::cin >> command).eof()) {
     try {
@@ -0,0 +1,43 @@
+#include "parallel_reducer.hpp"
+#include <cstdlib>
+#include <string>
+
+namespace {
+  constexpr std::size_t default_threshold = 10000;
+
+  std::size_t get_env_number(const char* name, std::size_t default_value)
+  {
+    const char* value = std::getenv(name);
+    if (!value || *value == '\0') {
+      return default_value;
+    }
+    std::size_t processed = 0;
+    std::size_t result = std::stoull(value, &processed);
+    if (value[processed] != '\0') {
+      throw std::invalid_argument("invalid environment variable");
+    }
+    return result;
+  }
+}
+
+maslevtsov::ParallelReducer::ParallelReducer():
+  pool_(nullptr),
+  threshold_(0)
+{}
+
+maslevtsov::ParallelReducer::ParallelReducer(std::size_t threads_num, std::size_t threshold):
+  pool_(threads_num > 1 ? std::make_unique< ThreadPool >(threads_num) : nullptr),
+  threshold_(threshold)
+{}
+
+bool maslevtsov::ParallelReducer::is_parallel(std::size_t polygons_num) const noexcept
+{
+  return pool_ && polygons_num >= threshold_;
+}
+
+maslevtsov::ParallelReducer maslevtsov::make_env_reducer()
+{
+  std::size_t threads_num = get_env_number("MASLEVTSOV_THREADS", 0);
+  std::size_t threshold = get_env_number("MASLEVTSOV_PARALLEL_THRESHOLD", default_threshold);
+  return ParallelReducer(threads_num, threshold);
+}
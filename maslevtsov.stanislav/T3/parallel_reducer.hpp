@@ -0,0 +1,92 @@
+#ifndef PARALLEL_REDUCER_HPP
+#define PARALLEL_REDUCER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include "shapes.hpp"
+#include "thread_pool.hpp"
+
+namespace maslevtsov {
+  class ParallelReducer
+  {
+  public:
+    ParallelReducer();
+    ParallelReducer(std::size_t threads_num, std::size_t threshold);
+
+    bool is_parallel(std::size_t polygons_num) const noexcept;
+    template< class T, class Map, class Reduce >
+    T map_reduce(const std::vector< Polygon >& polygons, T identity, Map map, Reduce reduce) const;
+
+  private:
+    std::unique_ptr< ThreadPool > pool_;
+    std::size_t threshold_;
+  };
+
+  ParallelReducer make_env_reducer();
+
+  namespace detail {
+    template< class T, class Step >
+    struct ChunkReduction
+    {
+      const std::vector< Polygon >& polygons;
+      std::size_t chunk;
+      std::size_t chunks_num;
+      T identity;
+      Step step;
+
+      T operator()() const;
+    };
+
+    template< class T, class Step >
+    struct ChunkSubmitter
+    {
+      ThreadPool& pool;
+      const std::vector< Polygon >& polygons;
+      std::size_t chunks_num;
+      T identity;
+      Step step;
+
+      std::future< T > operator()(std::size_t chunk) const;
+    };
+  }
+}
+
+template< class T, class Map, class Reduce >
+T maslevtsov::ParallelReducer::map_reduce(const std::vector< Polygon >& polygons, T identity, Map map,
+  Reduce reduce) const
+{
+  using namespace std::placeholders;
+  auto step = std::bind(reduce, _1, std::bind(map, _2));
+  if (!is_parallel(polygons.size())) {
+    return std::accumulate(polygons.cbegin(), polygons.cend(), identity, step);
+  }
+  std::vector< std::size_t > chunks(pool_->size());
+  std::iota(chunks.begin(), chunks.end(), 0);
+  std::vector< std::future< T > > futures;
+  futures.reserve(chunks.size());
+  detail::ChunkSubmitter< T, decltype(step) > submitter{*pool_, polygons, chunks.size(), identity, step};
+  std::transform(chunks.cbegin(), chunks.cend(), std::back_inserter(futures), submitter);
+  std::vector< T > partials;
+  partials.reserve(futures.size());
+  std::transform(futures.begin(), futures.end(), std::back_inserter(partials), std::mem_fn(&std::future< T >::get));
+  return std::accumulate(partials.cbegin(), partials.cend(), identity, reduce);
+}
+
+template< class T, class Step >
+T maslevtsov::detail::ChunkReduction< T, Step >::operator()() const
+{
+  auto begin = polygons.cbegin() + polygons.size() * chunk / chunks_num;
+  auto end = polygons.cbegin() + polygons.size() * (chunk + 1) / chunks_num;
+  return std::accumulate(begin, end, identity, step);
+}
+
+template< class T, class Step >
+std::future< T > maslevtsov::detail::ChunkSubmitter< T, Step >::operator()(std::size_t chunk) const
+{
+  return pool.submit(ChunkReduction< T, Step >{polygons, chunk, chunks_num, identity, step});
+}
+
+#endif
@@ -46,6 +46,71 @@ double maslevtsov::get_polygon_area(const Polygon& polygon)
   return area;
 }
 
+long long maslevtsov::cross_product(const Point& lhs, const Point& rhs)
+{
+  return static_cast< long long >(lhs.x) * rhs.y - static_cast< long long >(lhs.y) * rhs.x;
+}
+
+long long maslevtsov::get_doubled_area(const Polygon& polygon)
+{
+  auto begin_it = polygon.points.cbegin();
+  auto end_it = polygon.points.cend();
+  long long area = std::inner_product(begin_it, end_it - 1, begin_it + 1, 0LL, std::plus< long long >(), cross_product);
+  area += cross_product(polygon.points.back(), polygon.points.front());
+  return std::abs(area);
+}
+
+namespace {
+  long long orientation(const maslevtsov::Point& begin, const maslevtsov::Point& end, const maslevtsov::Point& point)
+  {
+    long long edge_x = static_cast< long long >(end.x) - begin.x;
+    long long edge_y = static_cast< long long >(end.y) - begin.y;
+    long long to_point_x = static_cast< long long >(point.x) - begin.x;
+    long long to_point_y = static_cast< long long >(point.y) - begin.y;
+    return edge_x * to_point_y - edge_y * to_point_x;
+  }
+}
+
+bool maslevtsov::is_on_edge(const Point& begin, const Point& end, const Point& point)
+{
+  if (orientation(begin, end, point) != 0) {
+    return false;
+  }
+  bool in_x_range = std::min(begin.x, end.x) <= point.x && point.x <= std::max(begin.x, end.x);
+  bool in_y_range = std::min(begin.y, end.y) <= point.y && point.y <= std::max(begin.y, end.y);
+  return in_x_range && in_y_range;
+}
+
+bool maslevtsov::crosses_ray(const Point& begin, const Point& end, const Point& point)
+{
+  bool upward = begin.y <= point.y && point.y < end.y;
+  bool downward = end.y <= point.y && point.y < begin.y;
+  if (!upward && !downward) {
+    return false;
+  }
+  long long side = orientation(begin, end, point);
+  return upward ? side > 0 : side < 0;
+}
+
+bool maslevtsov::contains_point(const Polygon& polygon, const Point& point)
+{
+  using namespace std::placeholders;
+  auto begin_it = polygon.points.cbegin();
+  auto end_it = polygon.points.cend();
+  auto on_edge = std::bind(is_on_edge, _1, _2, point);
+  if (std::inner_product(begin_it, end_it - 1, begin_it + 1, false, std::logical_or< bool >(), on_edge)) {
+    return true;
+  }
+  if (on_edge(polygon.points.back(), polygon.points.front())) {
+    return true;
+  }
+  auto crosses = std::bind(crosses_ray, _1, _2, point);
+  std::size_t crossings = std::inner_product(begin_it, end_it - 1, begin_it + 1, std::size_t(0),
+    std::plus< std::size_t >(), crosses);
+  crossings += crosses(polygon.points.back(), polygon.points.front());
+  return crossings % 2 == 1;
+}
+
 bool maslevtsov::compare_vertex_num_less(const Polygon& lhs, const Polygon& rhs)
 {
   return lhs.points.size() < rhs.points.size();
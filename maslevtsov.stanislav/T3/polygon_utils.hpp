@@ -11,6 +11,12 @@ namespace maslevtsov {
   double add_main_diagonal(const Point& lhs, const Point& rhs);
   double subtract_sub_diagonal(const Point& lhs, const Point& rhs);
   double get_polygon_area(const Polygon& polygon);
+  long long cross_product(const Point& lhs, const Point& rhs);
+  long long get_doubled_area(const Polygon& polygon);
+
+  bool is_on_edge(const Point& begin, const Point& end, const Point& point);
+  bool crosses_ray(const Point& begin, const Point& end, const Point& point);
+  bool contains_point(const Polygon& polygon, const Point& point);
 
   bool compare_vertex_num_less(const Polygon& lhs, const Polygon& rhs);
   bool is_same(const Polygon& lhs, const Polygon& rhs);
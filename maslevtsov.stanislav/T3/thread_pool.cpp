@@ -0,0 +1,56 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <iterator>
+
+maslevtsov::ThreadPool::ThreadPool(std::size_t threads_num):
+  workers_(),
+  tasks_(),
+  mutex_(),
+  condition_(),
+  is_stopped_(false)
+{
+  workers_.reserve(threads_num);
+  std::generate_n(std::back_inserter(workers_), threads_num, std::bind(&ThreadPool::spawn, this));
+}
+
+maslevtsov::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    is_stopped_ = true;
+  }
+  condition_.notify_all();
+  std::for_each(workers_.begin(), workers_.end(), std::mem_fn(&std::thread::join));
+}
+
+std::size_t maslevtsov::ThreadPool::size() const noexcept
+{
+  return workers_.size();
+}
+
+std::thread maslevtsov::ThreadPool::spawn()
+{
+  return std::thread(&ThreadPool::work, this);
+}
+
+void maslevtsov::ThreadPool::work()
+{
+  while (true) {
+    std::function< void() > task;
+    {
+      std::unique_lock< std::mutex > lock(mutex_);
+      condition_.wait(lock, std::bind(&ThreadPool::is_ready, this));
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+bool maslevtsov::ThreadPool::is_ready() const noexcept
+{
+  return is_stopped_ || !tasks_.empty();
+}
@@ -0,0 +1,56 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace maslevtsov {
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(std::size_t threads_num);
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const noexcept;
+    template< class F >
+    std::future< typename std::result_of< F() >::type > submit(F task);
+
+  private:
+    std::vector< std::thread > workers_;
+    std::queue< std::function< void() > > tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool is_stopped_;
+
+    std::thread spawn();
+    void work();
+    bool is_ready() const noexcept;
+  };
+}
+
+template< class F >
+std::future< typename std::result_of< F() >::type > maslevtsov::ThreadPool::submit(F task)
+{
+  using result_t = typename std::result_of< F() >::type;
+  using packaged_t = std::packaged_task< result_t() >;
+  auto packaged = std::make_shared< packaged_t >(std::move(task));
+  std::future< result_t > result = packaged->get_future();
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    tasks_.emplace(std::bind(&packaged_t::operator(), packaged));
+  }
+  condition_.notify_one();
+  return result;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include "half_io.h"
+#include <iostream>
+
+std::ostream& ohantsev::operator<<(std::ostream& out, const HalfIO& src)
+{
+  std::ostream::sentry sentry(out);
+  if (!sentry)
+  {
+    return out;
+  }
+  static constexpr std::size_t MAX_DIGITS = 48;
+  char buffer[MAX_DIGITS];
+  char* const last = buffer + MAX_DIGITS;
+  char* first = last;
+  const bool negative = src.doubled < 0;
+  UnsignedAreaSum magnitude = negative ? -static_cast< UnsignedAreaSum >(src.doubled) : src.doubled;
+  *--first = (magnitude % 2 == 0) ? '0' : '5';
+  *--first = '.';
+  magnitude /= 2;
+  do
+  {
+    *--first = static_cast< char >('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  while (magnitude != 0);
+  if (negative)
+  {
+    *--first = '-';
+  }
+  return out.write(first, last - first);
+}
@@ -0,0 +1,15 @@
+#ifndef HALF_IO_H
+#define HALF_IO_H
+#include <iosfwd>
+#include "polygon.h"
+
+namespace ohantsev
+{
+  struct HalfIO
+  {
+    AreaSum doubled;
+  };
+
+  std::ostream& operator<<(std::ostream& out, const HalfIO& src);
+}
+#endif
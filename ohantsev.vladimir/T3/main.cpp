@@ -1,7 +1,9 @@
+#include <string>
 #include <vector>
 #include <fstream>
 #include <iostream>
 #include "cmds_run.h"
+#include "snapshot.h"
 
 int main(int argc, char* argv[])
 {
@@ -20,6 +22,17 @@ int main(int argc, char* argv[])
     return 1;
   }
   std::vector< Polygon > polygons;
-  fillPolygons(polygons, in);
+  const std::string snapshot = ohantsev::snapshotPath(argv[1]);
+  ohantsev::SourceStamp source{};
+  const bool stamped = ohantsev::sourceStamp(argv[1], source);
+  if (!stamped || !ohantsev::isSnapshotFresh(argv[1], snapshot) || !ohantsev::loadSnapshot(snapshot, source, polygons))
+  {
+    polygons.clear();
+    fillPolygons(polygons, in);
+    if (stamped && !ohantsev::saveSnapshot(snapshot, polygons, source))
+    {
+      std::cerr << "Cannot save snapshot " << snapshot << '\n';
+    }
+  }
   cmdsHandle(polygons, std::cin, std::cout);
 }
@@ -0,0 +1,66 @@
+#include "perms_index.h"
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+ohantsev::PermsIndex::PermsIndex(const std::vector< Polygon >& polygons):
+  polygons_(polygons),
+  entries_()
+{
+  using namespace std::placeholders;
+  std::vector< std::size_t > positions(polygons.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  entries_.reserve(polygons.size());
+  std::for_each(positions.cbegin(), positions.cend(), std::bind(&PermsIndex::add, this, _1));
+}
+
+void ohantsev::PermsIndex::add(std::size_t pos)
+{
+  const Polygon& polygon = polygons_[pos];
+  const std::size_t hash = canonicalHash(polygon);
+  auto range = entries_.equal_range(hash);
+  auto found = std::find_if(range.first, range.second, SameAs{ polygons_, polygon });
+  if (found == range.second)
+  {
+    entries_.emplace(hash, Entry{ pos, 1 });
+    return;
+  }
+  ++found->second.count;
+}
+
+std::size_t ohantsev::PermsIndex::count(const Polygon& polygon) const
+{
+  auto range = entries_.equal_range(canonicalHash(polygon));
+  auto found = std::find_if(range.first, range.second, SameAs{ polygons_, polygon });
+  return found == range.second ? 0 : found->second.count;
+}
+
+bool ohantsev::PermsIndex::SameAs::operator()(const Entries::value_type& entry) const
+{
+  return isPermutation(polygons[entry.second.representative], polygon);
+}
+
+std::size_t ohantsev::pointHash(const Point& point) noexcept
+{
+  std::size_t hash = std::hash< int >{}(point.x);
+  hash ^= std::hash< int >{}(point.y) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+  hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+  return (hash >> 16) ^ hash;
+}
+
+std::size_t ohantsev::canonicalHash(const Polygon& polygon) noexcept
+{
+  using namespace std::placeholders;
+  auto addPoint = std::bind(std::plus< std::size_t >{}, _1, std::bind(pointHash, _2));
+  return std::accumulate(polygon.points.cbegin(), polygon.points.cend(), polygon.size(), addPoint);
+}
+
+bool ohantsev::isPermutation(const Polygon& lhs, const Polygon& rhs)
+{
+  if (lhs.size() != rhs.size())
+  {
+    return false;
+  }
+  return std::is_permutation(lhs.points.cbegin(), lhs.points.cend(), rhs.points.cbegin());
+}
@@ -0,0 +1,40 @@
+#ifndef PERMS_INDEX_H
+#define PERMS_INDEX_H
+#include <vector>
+#include <unordered_map>
+#include "polygon.h"
+
+namespace ohantsev
+{
+  class PermsIndex
+  {
+  public:
+    explicit PermsIndex(const std::vector< Polygon >& polygons);
+
+    void add(std::size_t pos);
+    std::size_t count(const Polygon& polygon) const;
+
+  private:
+    struct Entry
+    {
+      std::size_t representative;
+      std::size_t count;
+    };
+    using Entries = std::unordered_multimap< std::size_t, Entry >;
+
+    struct SameAs
+    {
+      const std::vector< Polygon >& polygons;
+      const Polygon& polygon;
+      bool operator()(const Entries::value_type& entry) const;
+    };
+
+    const std::vector< Polygon >& polygons_;
+    Entries entries_;
+  };
+
+  std::size_t pointHash(const Point& point) noexcept;
+  std::size_t canonicalHash(const Polygon& polygon) noexcept;
+  bool isPermutation(const Polygon& lhs, const Polygon& rhs);
+}
+#endif
@@ -1,30 +1,35 @@
 #include "polygon.h"
-#include <vector>
 #include <numeric>
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <functional>
 #include <algorithm>
 #include <delimiter.h>
 
-int ohantsev::areaGaussPairSum(const Point& lhs, const Point& rhs)
+auto ohantsev::areaGaussPairSum(const Point& lhs, const Point& rhs) -> DoubledArea
 {
-  return lhs.x * rhs.y - rhs.x * lhs.y;
+  return DoubledArea{ lhs.x } * rhs.y - DoubledArea{ rhs.x } * lhs.y;
 }
 
 double ohantsev::getArea(const Polygon& polygon)
 {
-  std::vector< int > counting;
-  counting.reserve(polygon.size());
-  std::transform
+  return getDoubledArea(polygon) / 2.0;
+}
+
+auto ohantsev::getDoubledArea(const Polygon& polygon) -> DoubledArea
+{
+  DoubledArea doubledArea = std::inner_product
   (
     polygon.points.cbegin(),
     polygon.points.cend() - 1,
     polygon.points.cbegin() + 1,
-    std::back_inserter(counting),
+    DoubledArea{ 0 },
+    std::plus< DoubledArea >{},
     areaGaussPairSum
   );
-  counting.push_back(areaGaussPairSum(polygon.points.back(), polygon.points.front()));
-  return std::abs(std::accumulate(counting.begin(), counting.end(), 0)) / 2.0;
+  doubledArea += areaGaussPairSum(polygon.points.back(), polygon.points.front());
+  return std::abs(doubledArea);
 }
 
 std::size_t ohantsev::Polygon::size() const noexcept
@@ -2,9 +2,19 @@
 #define POLYGON_H
 #include <vector>
 #include <iosfwd>
+#include <cstdint>
 
 namespace ohantsev
 {
+  using DoubledArea = std::int64_t;
+#ifdef __SIZEOF_INT128__
+  using AreaSum = __int128;
+  using UnsignedAreaSum = unsigned __int128;
+#else
+  using AreaSum = long long;
+  using UnsignedAreaSum = unsigned long long;
+#endif
+
   struct Point
   {
     int x, y;
@@ -20,7 +30,8 @@ namespace ohantsev
   };
 
   double getArea(const Polygon& polygon);
-  int areaGaussPairSum(const Point& lhs, const Point& rhs);
+  DoubledArea getDoubledArea(const Polygon& polygon);
+  DoubledArea areaGaussPairSum(const Point& lhs, const Point& rhs);
   std::istream& operator>>(std::istream& in, Point& rhs);
   std::istream& operator>>(std::istream& in, Polygon& rhs);
 }
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <functional>
 #include <iofmtguard.h>
+#include "half_io.h"
 
 bool ohantsev::isOdd(const Polygon& polygon) noexcept
 {
@@ -31,13 +32,13 @@ bool ohantsev::lessSize(const Polygon& lhs, const Polygon& rhs) noexcept
   return lhs.size() < rhs.size();
 }
 
-ohantsev::Area::Area(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out):
+ohantsev::Area::Area(const VertexTable& table,  std::istream& in, std::ostream& out):
   CommandHandler(in, out),
-  polygons_(polygons)
+  table_(table)
 {
-  add("EVEN", std::bind(even, std::cref(polygons), std::ref(out)));
-  add("ODD", std::bind(odd, std::cref(polygons), std::ref(out)));
-  add("MEAN", std::bind(mean, std::cref(polygons), std::ref(out)));
+  add("EVEN", std::bind(even, std::cref(table), std::ref(out)));
+  add("ODD", std::bind(odd, std::cref(table), std::ref(out)));
+  add("MEAN", std::bind(mean, std::cref(table), std::ref(out)));
 }
 
 void ohantsev::Area::operator()()
@@ -57,48 +58,33 @@ void ohantsev::Area::operator()()
     {
       throw std::invalid_argument("invalid subcommand");
     }
-    numOfVertexes(polygons_, out_, vertexes);
+    numOfVertexes(table_, out_, vertexes);
   }
 }
 
-double ohantsev::Area::accumulateArea(const std::vector< Polygon >& polygons)
-{
-  std::vector< double > areas(polygons.size());
-  std::transform(polygons.cbegin(), polygons.cend(), areas.begin(), getArea);
-  return std::accumulate(areas.cbegin(), areas.cend(), 0.0);
-}
-
-double ohantsev::Area::accumulateAreaIf(const std::vector< Polygon >& polygons, const std::function< bool(const Polygon&) >& sign)
-{
-  std::vector< Polygon > validPolygons;
-  validPolygons.reserve(polygons.size());
-  std::copy_if(polygons.cbegin(), polygons.cend(), std::back_inserter(validPolygons), sign);
-  return accumulateArea(validPolygons);
-}
-
-void ohantsev::Area::odd(const std::vector< Polygon >& polygons, std::ostream& out)
+void ohantsev::Area::odd(const VertexTable& table, std::ostream& out)
 {
-  out << accumulateAreaIf(polygons, isOdd) << '\n';
+  out << HalfIO{ table.odd().doubledArea } << '\n';
 }
 
-void ohantsev::Area::even(const std::vector< Polygon >& polygons, std::ostream& out)
+void ohantsev::Area::even(const VertexTable& table, std::ostream& out)
 {
-  out << accumulateAreaIf(polygons, isEven) << '\n';
+  out << HalfIO{ table.even().doubledArea } << '\n';
 }
 
-void ohantsev::Area::numOfVertexes(const std::vector< Polygon >& polygons, std::ostream& out, std::size_t num)
+void ohantsev::Area::numOfVertexes(const VertexTable& table, std::ostream& out, std::size_t num)
 {
-  using namespace std::placeholders;
-  out << accumulateAreaIf(polygons, std::bind(thisSize, _1, num)) << '\n';
+  out << HalfIO{ table.at(num).doubledArea } << '\n';
 }
 
-void ohantsev::Area::mean(const std::vector< Polygon >& polygons, std::ostream& out)
+void ohantsev::Area::mean(const VertexTable& table, std::ostream& out)
 {
-  if (polygons.empty())
+  const VertexTable::Row total = table.total();
+  if (total.count == 0)
   {
     throw std::invalid_argument("there are no polygons");
   }
-  out << accumulateArea(polygons) / polygons.size() << '\n';
+  out << static_cast< double >(total.doubledArea) / 2.0 / total.count << '\n';
 }
 
 ohantsev::Max::Max(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out):
@@ -115,9 +101,9 @@ void ohantsev::Max::area(const std::vector< Polygon >& polygons, std::ostream& o
   {
     throw std::invalid_argument("there are no polygons");
   }
-  std::vector< double > areas(polygons.size());
-  std::transform(polygons.cbegin(), polygons.cend(), areas.begin(), getArea);
-  out << *std::max_element(areas.cbegin(), areas.cend()) << '\n';
+  std::vector< DoubledArea > areas(polygons.size());
+  std::transform(polygons.cbegin(), polygons.cend(), areas.begin(), getDoubledArea);
+  out << HalfIO{ *std::max_element(areas.cbegin(), areas.cend()) } << '\n';
 }
 
 void ohantsev::Max::vertexes(const std::vector< Polygon >& polygons, std::ostream& out)
@@ -143,9 +129,9 @@ void ohantsev::Min::area(const std::vector< Polygon >& polygons, std::ostream& o
   {
     throw std::invalid_argument("there are no polygons");
   }
-  std::vector< double > areas(polygons.size());
-  std::transform(polygons.cbegin(), polygons.cend(), areas.begin(), getArea);
-  out << *std::min_element(areas.cbegin(), areas.cend()) << '\n';
+  std::vector< DoubledArea > areas(polygons.size());
+  std::transform(polygons.cbegin(), polygons.cend(), areas.begin(), getDoubledArea);
+  out << HalfIO{ *std::min_element(areas.cbegin(), areas.cend()) } << '\n';
 }
 
 void ohantsev::Min::vertexes(const std::vector< Polygon >& polygons, std::ostream& out)
@@ -157,12 +143,12 @@ void ohantsev::Min::vertexes(const std::vector< Polygon >& polygons, std::ostrea
   out << std::min_element(polygons.cbegin(), polygons.cend(), lessSize)->size() << '\n';
 }
 
-ohantsev::Count::Count(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out):
+ohantsev::Count::Count(const VertexTable& table,  std::istream& in, std::ostream& out):
   CommandHandler(in, out),
-  polygons_(polygons)
+  table_(table)
 {
-  add("EVEN", std::bind(even, std::cref(polygons), std::ref(out)));
-  add("ODD", std::bind(odd, std::cref(polygons), std::ref(out)));
+  add("EVEN", std::bind(even, std::cref(table), std::ref(out)));
+  add("ODD", std::bind(odd, std::cref(table), std::ref(out)));
 }
 
 void ohantsev::Count::operator()()
@@ -182,34 +168,35 @@ void ohantsev::Count::operator()()
     {
       throw std::invalid_argument("invalid subcommand");
     }
-    numOfVertexes(polygons_, out_, num);
+    numOfVertexes(table_, out_, num);
   }
 }
 
-void ohantsev::Count::odd(const std::vector< Polygon >& polygons, std::ostream& out)
+void ohantsev::Count::odd(const VertexTable& table, std::ostream& out)
 {
-  out << std::count_if(polygons.cbegin(), polygons.cend(), isOdd) << '\n';
+  out << table.odd().count << '\n';
 }
 
-void ohantsev::Count::even(const std::vector< Polygon >& polygons, std::ostream& out)
+void ohantsev::Count::even(const VertexTable& table, std::ostream& out)
 {
-  out << std::count_if(polygons.cbegin(), polygons.cend(), isEven) << '\n';
+  out << table.even().count << '\n';
 }
 
-void ohantsev::Count::numOfVertexes(const std::vector< Polygon >& polygons, std::ostream& out, std::size_t num)
+void ohantsev::Count::numOfVertexes(const VertexTable& table, std::ostream& out, std::size_t num)
 {
-  using namespace std::placeholders;
-  out << std::count_if(polygons.cbegin(), polygons.cend(), std::bind(thisSize, _1, num)) << '\n';
+  out << table.at(num).count << '\n';
 }
 
 ohantsev::PolygonCmdsHandler::PolygonCmdsHandler(std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out):
-  CommandHandler(in, out)
+  CommandHandler(in, out),
+  permsIndex_(polygons),
+  vertexTable_(polygons)
 {
-  add("AREA", Area{ polygons, in, out });
+  add("AREA", Area{ vertexTable_, in, out });
   add("MAX", Max{ polygons, in, out });
   add("MIN", Min{ polygons, in, out });
-  add("COUNT", Count{ polygons, in, out });
-  add("PERMS", std::bind(perms, std::cref(polygons), std::ref(in), std::ref(out)));
+  add("COUNT", Count{ vertexTable_, in, out });
+  add("PERMS", std::bind(perms, std::cref(permsIndex_), std::ref(in), std::ref(out)));
   add("RECTS", std::bind(rects, std::cref(polygons), std::ref(out)));
 }
 
@@ -244,27 +231,14 @@ void ohantsev::PolygonCmdsHandler::processUntilEOF()
   }
 }
 
-auto ohantsev::getSorted(const Polygon& polygon) -> Polygon
-{
-  Polygon res = polygon;
-  std::sort(res.points.begin(), res.points.end());
-  return res;
-}
-
-void ohantsev::perms(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out)
+void ohantsev::perms(const PermsIndex& index, std::istream& in, std::ostream& out)
 {
-  using namespace std::placeholders;
   Polygon example;
   if (!(in >> example))
   {
     throw std::invalid_argument("invalid perms polygon");
   }
-  std::sort(example.points.begin(), example.points.end());
-  std::vector< Polygon > sorted;
-  sorted.reserve(polygons.size());
-  auto equalToExample = std::bind(&Polygon::operator==, &example, _1);
-  std::transform(polygons.cbegin(), polygons.cend(), std::back_inserter(sorted), getSorted);
-  out << std::count_if(sorted.cbegin(), sorted.cend(), equalToExample) << '\n';
+  out << index.count(example) << '\n';
 }
 
 void ohantsev::rects(const std::vector< Polygon >& polygons, std::ostream& out)
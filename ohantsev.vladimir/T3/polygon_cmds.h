@@ -5,6 +5,8 @@
 #include <functional>
 #include <command_handler.h>
 #include "polygon.h"
+#include "perms_index.h"
+#include "vertex_table.h"
 
 namespace ohantsev
 {
@@ -17,18 +19,15 @@ namespace ohantsev
   {
   public:
     void operator()() override;
-    Area(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out);
+    Area(const VertexTable& table,  std::istream& in, std::ostream& out);
 
   private:
-    const std::vector< Polygon >& polygons_;
-
-    static void odd(const std::vector< Polygon >& polygons, std::ostream& out);
-    static void even(const std::vector< Polygon >& polygons, std::ostream& out);
-    static void numOfVertexes(const std::vector< Polygon >& polygons, std::ostream& out, std::size_t num);
-    static void mean(const std::vector< Polygon >& polygons, std::ostream& out);
+    const VertexTable& table_;
 
-    static double accumulateArea(const std::vector< Polygon >& polygons);
-    static double accumulateAreaIf(const std::vector< Polygon >& polygons, const std::function< bool(const Polygon&) >& sign);
+    static void odd(const VertexTable& table, std::ostream& out);
+    static void even(const VertexTable& table, std::ostream& out);
+    static void numOfVertexes(const VertexTable& table, std::ostream& out, std::size_t num);
+    static void mean(const VertexTable& table, std::ostream& out);
   };
 
   class Max: public CommandHandler
@@ -59,26 +58,34 @@ namespace ohantsev
   {
   public:
     void operator()() override;
-    Count(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out);
+    Count(const VertexTable& table,  std::istream& in, std::ostream& out);
 
   private:
-    const std::vector< Polygon >& polygons_;
+    const VertexTable& table_;
 
-    static void odd(const std::vector< Polygon >& polygons, std::ostream& out);
-    static void even(const std::vector< Polygon >& polygons, std::ostream& out);
-    static void numOfVertexes(const std::vector< Polygon >& polygons, std::ostream& out, std::size_t num);
+    static void odd(const VertexTable& table, std::ostream& out);
+    static void even(const VertexTable& table, std::ostream& out);
+    static void numOfVertexes(const VertexTable& table, std::ostream& out, std::size_t num);
   };
 
   class PolygonCmdsHandler: public CommandHandler
   {
   public:
     PolygonCmdsHandler(std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out);
+    PolygonCmdsHandler(const PolygonCmdsHandler&) = delete;
+    PolygonCmdsHandler(PolygonCmdsHandler&&) = delete;
+    PolygonCmdsHandler& operator=(const PolygonCmdsHandler&) = delete;
+    PolygonCmdsHandler& operator=(PolygonCmdsHandler&&) = delete;
     void operator()() override;
     void processUntilEOF();
+
+  private:
+    // the stored commands refer to these members, so the handler stays put
+    PermsIndex permsIndex_;
+    VertexTable vertexTable_;
   };
 
-  void perms(const std::vector< Polygon >& polygons,  std::istream& in, std::ostream& out);
-  Polygon getSorted(const Polygon& polygon);
+  void perms(const PermsIndex& index, std::istream& in, std::ostream& out);
 
   void rects(const std::vector< Polygon >& polygons, std::ostream& out);
   bool isRect(const Polygon& polygon);
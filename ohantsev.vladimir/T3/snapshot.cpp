@@ -0,0 +1,311 @@
+#include "snapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OHANTSEV_SNAPSHOT_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  using ohantsev::Point;
+  using ohantsev::Polygon;
+  using ohantsev::SnapshotHeader;
+
+  static_assert(sizeof(SnapshotHeader) == 56, "snapshot header must not be padded");
+  static_assert(sizeof(Point) == 2 * sizeof(std::int32_t), "point must be two packed int32 coordinates");
+  static_assert(std::is_trivially_copyable< Point >::value, "point must be trivially copyable");
+
+  const char SNAPSHOT_MAGIC[4] = { 'O', 'H', 'P', 'S' };
+
+  class SnapshotFile
+  {
+  public:
+    explicit SnapshotFile(const std::string& path);
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+    ~SnapshotFile();
+
+    const char* data() const noexcept;
+    std::size_t size() const noexcept;
+
+  private:
+    const char* data_;
+    std::size_t size_;
+    std::vector< std::uint64_t > buffer_;
+  };
+
+  SnapshotFile::SnapshotFile(const std::string& path):
+    data_(nullptr),
+    size_(0),
+    buffer_()
+  {
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+      ::close(fd);
+      return;
+    }
+    if (st.st_size > 0)
+    {
+      void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+        data_ = static_cast< const char* >(addr);
+        size_ = st.st_size;
+      }
+    }
+    ::close(fd);
+    if (data_)
+    {
+      return;
+    }
+#endif
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+      return;
+    }
+    std::size_t size = file.tellg();
+    buffer_.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    file.seekg(0);
+    if (file.read(reinterpret_cast< char* >(buffer_.data()), size))
+    {
+      data_ = reinterpret_cast< const char* >(buffer_.data());
+      size_ = size;
+    }
+  }
+
+  SnapshotFile::~SnapshotFile()
+  {
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+    if (data_ && buffer_.empty())
+    {
+      ::munmap(const_cast< char* >(data_), size_);
+    }
+#endif
+  }
+
+  const char* SnapshotFile::data() const noexcept
+  {
+    return data_;
+  }
+
+  std::size_t SnapshotFile::size() const noexcept
+  {
+    return size_;
+  }
+
+  std::uint64_t mixWord(std::uint64_t hash, std::uint64_t word) noexcept
+  {
+    hash ^= word * 0x9e3779b97f4a7c15ULL;
+    hash = (hash << 27) | (hash >> 37);
+    return hash * 0xff51afd7ed558ccdULL + 0x165667b19e3779f9ULL;
+  }
+
+  bool isSameSource(const ohantsev::SourceStamp& lhs, const ohantsev::SourceStamp& rhs) noexcept
+  {
+    return lhs.size == rhs.size && lhs.mtimeSec == rhs.mtimeSec && lhs.mtimeNsec == rhs.mtimeNsec;
+  }
+
+  bool isBadOffsetPair(std::uint64_t lhs, std::uint64_t rhs) noexcept
+  {
+    return rhs < lhs || rhs - lhs < 3;
+  }
+
+  struct PointsAppender
+  {
+    std::vector< Point >& points;
+    void operator()(const Polygon& polygon) const
+    {
+      points.insert(points.end(), polygon.points.cbegin(), polygon.points.cend());
+    }
+  };
+
+  struct PolygonBuilder
+  {
+    const char* points;
+    Polygon operator()(std::uint64_t begin, std::uint64_t end) const
+    {
+      Polygon polygon{ std::vector< Point >(end - begin) };
+      std::memcpy(polygon.points.data(), points + begin * sizeof(Point), (end - begin) * sizeof(Point));
+      return polygon;
+    }
+  };
+
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+  bool modificationTime(const std::string& path, struct timespec& time)
+  {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0)
+    {
+      return false;
+    }
+#ifdef __APPLE__
+    time = st.st_mtimespec;
+#else
+    time = st.st_mtim;
+#endif
+    return true;
+  }
+#endif
+}
+
+std::string ohantsev::snapshotPath(const std::string& source)
+{
+  return source + ".snap";
+}
+
+bool ohantsev::sourceStamp(const std::string& source, SourceStamp& stamp)
+{
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+  struct stat st;
+  struct timespec time;
+  if (::stat(source.c_str(), &st) != 0 || !modificationTime(source, time))
+  {
+    return false;
+  }
+  stamp = SourceStamp{ static_cast< std::uint64_t >(st.st_size), time.tv_sec, time.tv_nsec };
+  return true;
+#else
+  static_cast< void >(source);
+  static_cast< void >(stamp);
+  return false;
+#endif
+}
+
+bool ohantsev::isSnapshotFresh(const std::string& source, const std::string& snapshot)
+{
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+  struct timespec sourceTime;
+  struct timespec snapshotTime;
+  if (!modificationTime(source, sourceTime) || !modificationTime(snapshot, snapshotTime))
+  {
+    return false;
+  }
+  if (snapshotTime.tv_sec != sourceTime.tv_sec)
+  {
+    return snapshotTime.tv_sec > sourceTime.tv_sec;
+  }
+  return snapshotTime.tv_nsec > sourceTime.tv_nsec;
+#else
+  static_cast< void >(source);
+  static_cast< void >(snapshot);
+  return false;
+#endif
+}
+
+std::uint64_t ohantsev::snapshotChecksum(const std::uint64_t* begin, const std::uint64_t* end) noexcept
+{
+  return std::accumulate(begin, end, std::uint64_t(end - begin), mixWord);
+}
+
+bool ohantsev::saveSnapshot(const std::string& path, const std::vector< Polygon >& polygons, const SourceStamp& source)
+{
+  std::vector< std::uint64_t > offsets(1, 0);
+  offsets.reserve(polygons.size() + 1);
+  std::transform(polygons.cbegin(), polygons.cend(), std::back_inserter(offsets), std::mem_fn(&Polygon::size));
+  std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+  std::vector< std::uint64_t > payload(offsets.size() + offsets.back());
+  std::copy(offsets.cbegin(), offsets.cend(), payload.begin());
+  std::vector< Point > points;
+  points.reserve(offsets.back());
+  std::for_each(polygons.cbegin(), polygons.cend(), PointsAppender{ points });
+  if (!points.empty())
+  {
+    std::memcpy(payload.data() + offsets.size(), points.data(), points.size() * sizeof(Point));
+  }
+
+  SnapshotHeader header{};
+  std::copy(std::begin(SNAPSHOT_MAGIC), std::end(SNAPSHOT_MAGIC), header.magic);
+  header.version = SNAPSHOT_VERSION;
+  header.polygons = polygons.size();
+  header.points = points.size();
+  header.checksum = snapshotChecksum(payload.data(), payload.data() + payload.size());
+  header.source = source;
+
+#ifdef OHANTSEV_SNAPSHOT_POSIX
+  const std::string temporary = path + "." + std::to_string(::getpid()) + ".tmp";
+#else
+  const std::string temporary = path + ".tmp";
+#endif
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast< const char* >(&header), sizeof(header));
+    out.write(reinterpret_cast< const char* >(payload.data()), payload.size() * sizeof(std::uint64_t));
+    if (!out.flush())
+    {
+      std::remove(temporary.c_str());
+      return false;
+    }
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ohantsev::loadSnapshot(const std::string& path, const SourceStamp& source, std::vector< Polygon >& polygons)
+{
+  SnapshotFile file(path);
+  if (!file.data() || file.size() < sizeof(SnapshotHeader))
+  {
+    return false;
+  }
+  SnapshotHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (!std::equal(std::begin(SNAPSHOT_MAGIC), std::end(SNAPSHOT_MAGIC), header.magic) || header.version != SNAPSHOT_VERSION)
+  {
+    return false;
+  }
+  if (!isSameSource(header.source, source))
+  {
+    return false;
+  }
+  const std::size_t words = (file.size() - sizeof(header)) / sizeof(std::uint64_t);
+  if (header.polygons >= words || header.points != words - header.polygons - 1)
+  {
+    return false;
+  }
+  if (file.size() != sizeof(header) + words * sizeof(std::uint64_t))
+  {
+    return false;
+  }
+  const std::uint64_t* payload = reinterpret_cast< const std::uint64_t* >(file.data() + sizeof(header));
+  if (snapshotChecksum(payload, payload + words) != header.checksum)
+  {
+    return false;
+  }
+  const std::uint64_t* offsets = payload;
+  const std::uint64_t* offsetsEnd = offsets + header.polygons + 1;
+  if (offsets[0] != 0 || offsetsEnd[-1] != header.points)
+  {
+    return false;
+  }
+  if (std::adjacent_find(offsets, offsetsEnd, isBadOffsetPair) != offsetsEnd)
+  {
+    return false;
+  }
+  const char* points = reinterpret_cast< const char* >(offsetsEnd);
+  polygons.reserve(polygons.size() + header.polygons);
+  std::transform(offsets, offsetsEnd - 1, offsets + 1, std::back_inserter(polygons), PolygonBuilder{ points });
+  return true;
+}
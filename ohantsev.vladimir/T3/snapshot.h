@@ -0,0 +1,36 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "polygon.h"
+
+namespace ohantsev
+{
+  struct SourceStamp
+  {
+    std::uint64_t size;
+    std::int64_t mtimeSec;
+    std::int64_t mtimeNsec;
+  };
+
+  struct SnapshotHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t polygons;
+    std::uint64_t points;
+    std::uint64_t checksum;
+    SourceStamp source;
+  };
+
+  constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+
+  std::string snapshotPath(const std::string& source);
+  bool sourceStamp(const std::string& source, SourceStamp& stamp);
+  bool isSnapshotFresh(const std::string& source, const std::string& snapshot);
+  bool saveSnapshot(const std::string& path, const std::vector< Polygon >& polygons, const SourceStamp& source);
+  bool loadSnapshot(const std::string& path, const SourceStamp& source, std::vector< Polygon >& polygons);
+  std::uint64_t snapshotChecksum(const std::uint64_t* begin, const std::uint64_t* end) noexcept;
+}
+#endif
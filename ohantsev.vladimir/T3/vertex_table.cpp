@@ -0,0 +1,66 @@
+#include "vertex_table.h"
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+ohantsev::VertexTable::VertexTable(const std::vector< Polygon >& polygons):
+  rows_()
+{
+  using namespace std::placeholders;
+  std::for_each(polygons.cbegin(), polygons.cend(), std::bind(&VertexTable::add, this, _1));
+}
+
+void ohantsev::VertexTable::add(const Polygon& polygon)
+{
+  Row& row = rows_[polygon.size()];
+  ++row.count;
+  row.doubledArea += getDoubledArea(polygon);
+}
+
+void ohantsev::VertexTable::remove(const Polygon& polygon)
+{
+  auto found = rows_.find(polygon.size());
+  if (found == rows_.end())
+  {
+    return;
+  }
+  if (--found->second.count == 0)
+  {
+    rows_.erase(found);
+    return;
+  }
+  found->second.doubledArea -= getDoubledArea(polygon);
+}
+
+auto ohantsev::VertexTable::at(std::size_t vertexes) const -> Row
+{
+  auto found = rows_.find(vertexes);
+  return found == rows_.cend() ? Row{ 0, 0 } : found->second;
+}
+
+auto ohantsev::VertexTable::even() const -> Row
+{
+  using namespace std::placeholders;
+  return std::accumulate(rows_.cbegin(), rows_.cend(), Row{ 0, 0 }, std::bind(addRowIf, false, _1, _2));
+}
+
+auto ohantsev::VertexTable::odd() const -> Row
+{
+  using namespace std::placeholders;
+  return std::accumulate(rows_.cbegin(), rows_.cend(), Row{ 0, 0 }, std::bind(addRowIf, true, _1, _2));
+}
+
+auto ohantsev::VertexTable::total() const -> Row
+{
+  return std::accumulate(rows_.cbegin(), rows_.cend(), Row{ 0, 0 }, addRow);
+}
+
+auto ohantsev::VertexTable::addRow(const Row& lhs, const Rows::value_type& rhs) noexcept -> Row
+{
+  return Row{ lhs.count + rhs.second.count, lhs.doubledArea + rhs.second.doubledArea };
+}
+
+auto ohantsev::VertexTable::addRowIf(bool odd, const Row& lhs, const Rows::value_type& rhs) noexcept -> Row
+{
+  return (rhs.first % 2 == 1) == odd ? addRow(lhs, rhs) : lhs;
+}
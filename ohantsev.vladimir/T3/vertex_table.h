@@ -0,0 +1,37 @@
+#ifndef VERTEX_TABLE_H
+#define VERTEX_TABLE_H
+#include <map>
+#include <vector>
+#include "polygon.h"
+
+namespace ohantsev
+{
+  class VertexTable
+  {
+  public:
+    struct Row
+    {
+      std::size_t count;
+      AreaSum doubledArea;
+    };
+
+    explicit VertexTable(const std::vector< Polygon >& polygons);
+
+    void add(const Polygon& polygon);
+    void remove(const Polygon& polygon);
+
+    Row at(std::size_t vertexes) const;
+    Row even() const;
+    Row odd() const;
+    Row total() const;
+
+  private:
+    using Rows = std::map< std::size_t, Row >;
+
+    Rows rows_;
+
+    static Row addRow(const Row& lhs, const Rows::value_type& rhs) noexcept;
+    static Row addRowIf(bool odd, const Row& lhs, const Rows::value_type& rhs) noexcept;
+  };
+}
+#endif
@@ -0,0 +1,107 @@
+#include "area_kernel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RYCHKOV_AREA_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  using kernel_type = long long(*)(const rychkov::Point*, size_t);
+
+  long long cross(const rychkov::Point& lhs, const rychkov::Point& rhs) noexcept
+  {
+    return static_cast< long long >(lhs.x) * rhs.y - static_cast< long long >(lhs.y) * rhs.x;
+  }
+  long long scalar_tail(const rychkov::Point* points, size_t from, size_t count) noexcept
+  {
+    long long result = cross(points[count - 1], points[0]);
+    for (size_t i = from; i + 1 < count; i++)
+    {
+      result += cross(points[i], points[i + 1]);
+    }
+    return result;
+  }
+  long long scalar_kernel(const rychkov::Point* points, size_t count)
+  {
+    return scalar_tail(points, 0, count);
+  }
+
+#ifdef RYCHKOV_AREA_KERNEL_X86
+#ifdef __SSE2__
+  // SSE2 has only an unsigned 32x32->64 multiply, so the signed product is
+  // restored by subtracting the two sign corrections shifted into the high half
+  __m128i mul_signed(__m128i lhs, __m128i rhs) noexcept
+  {
+    __m128i lhs_sign = _mm_srai_epi32(lhs, 31);
+    __m128i rhs_sign = _mm_srai_epi32(rhs, 31);
+    __m128i fix = _mm_add_epi32(_mm_and_si128(lhs, rhs_sign), _mm_and_si128(rhs, lhs_sign));
+    return _mm_sub_epi64(_mm_mul_epu32(lhs, rhs), _mm_slli_epi64(fix, 32));
+  }
+  long long sse2_kernel(const rychkov::Point* points, size_t count)
+  {
+    __m128i sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 3 <= count; i += 2)
+    {
+      __m128i cur = _mm_loadu_si128(reinterpret_cast< const __m128i* >(points + i));
+      __m128i next = _mm_loadu_si128(reinterpret_cast< const __m128i* >(points + i + 1));
+      __m128i main_diag = mul_signed(cur, _mm_shuffle_epi32(next, _MM_SHUFFLE(2, 3, 0, 1)));
+      __m128i sub_diag = mul_signed(_mm_srli_epi64(cur, 32), next);
+      sum = _mm_add_epi64(sum, _mm_sub_epi64(main_diag, sub_diag));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast< __m128i* >(lanes), sum);
+    return lanes[0] + lanes[1] + scalar_tail(points, i, count);
+  }
+#endif
+
+  __attribute__((target("avx2")))
+  long long avx2_kernel(const rychkov::Point* points, size_t count)
+  {
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 5 <= count; i += 4)
+    {
+      __m256i cur = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(points + i));
+      __m256i next = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(points + i + 1));
+      __m256i main_diag = _mm256_mul_epi32(cur, _mm256_shuffle_epi32(next, _MM_SHUFFLE(2, 3, 0, 1)));
+      __m256i sub_diag = _mm256_mul_epi32(_mm256_srli_epi64(cur, 32), next);
+      sum = _mm256_add_epi64(sum, _mm256_sub_epi64(main_diag, sub_diag));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast< __m256i* >(lanes), sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar_tail(points, i, count);
+  }
+#endif
+
+  kernel_type select_kernel() noexcept
+  {
+#ifdef RYCHKOV_AREA_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+      return avx2_kernel;
+    }
+#ifdef __SSE2__
+    return sse2_kernel;
+#endif
+#endif
+    return scalar_kernel;
+  }
+}
+
+long long rychkov::doubled_area(const Point* points, size_t count) noexcept
+{
+  if (count < 3)
+  {
+    return 0;
+  }
+  static const kernel_type kernel = select_kernel();
+  long long result = kernel(points, count);
+  return result < 0 ? -result : result;
+}
+long long rychkov::doubled_area(const Polygon& polygon) noexcept
+{
+  return doubled_area(polygon.points.data(), polygon.points.size());
+}
@@ -0,0 +1,13 @@
+#ifndef AREA_KERNEL_HPP
+#define AREA_KERNEL_HPP
+
+#include <cstddef>
+#include "polygon.hpp"
+
+namespace rychkov
+{
+  long long doubled_area(const Point* points, size_t count) noexcept;
+  long long doubled_area(const Polygon& polygon) noexcept;
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "centroid_tree.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+  using candidate = std::pair< double, size_t >;
+
+  struct moments
+  {
+    long long signed_area;
+    long double x_sum;
+    long double y_sum;
+  };
+  struct add_moments
+  {
+    moments operator()(const moments& lhs, const moments& rhs) const noexcept
+    {
+      return {lhs.signed_area + rhs.signed_area, lhs.x_sum + rhs.x_sum, lhs.y_sum + rhs.y_sum};
+    }
+  };
+  struct edge_moments
+  {
+    moments operator()(const rychkov::Point& cur, const rychkov::Point& next) const noexcept
+    {
+      long long cross = static_cast< long long >(cur.x) * next.y - static_cast< long long >(cur.y) * next.x;
+      return {cross, static_cast< long double >(cross) * (static_cast< long long >(cur.x) + next.x),
+            static_cast< long double >(cross) * (static_cast< long long >(cur.y) + next.y)};
+    }
+  };
+  struct add_vertex
+  {
+    moments operator()(const moments& sum, const rychkov::Point& point) const noexcept
+    {
+      return {sum.signed_area, sum.x_sum + point.x, sum.y_sum + point.y};
+    }
+  };
+  double squared_distance(const rychkov::Centroid& lhs, const rychkov::Centroid& rhs) noexcept
+  {
+    double dx = lhs.x - rhs.x;
+    double dy = lhs.y - rhs.y;
+    return dx * dx + dy * dy;
+  }
+}
+
+struct rychkov::CentroidTree::search_state
+{
+  const Centroid target;
+  const size_t count;
+  std::vector< candidate > best;
+
+  // best is a max-heap on distance, so its front is the worst of the kept candidates
+  void offer(const candidate& found)
+  {
+    if (best.size() < count)
+    {
+      best.push_back(found);
+      std::push_heap(best.begin(), best.end());
+    }
+    else if (found < best.front())
+    {
+      std::pop_heap(best.begin(), best.end());
+      best.back() = found;
+      std::push_heap(best.begin(), best.end());
+    }
+  }
+  bool worth_visiting(double plane_distance) const
+  {
+    return (best.size() < count) || (plane_distance * plane_distance <= best.front().first);
+  }
+};
+
+rychkov::Centroid rychkov::get_centroid(const Polygon& polygon) noexcept
+{
+  const std::vector< Point >& points = polygon.points;
+  if (points.empty())
+  {
+    return {0.0, 0.0};
+  }
+  moments edges = std::inner_product(points.begin(), points.end() - 1, points.begin() + 1, moments{0, 0, 0},
+        add_moments{}, edge_moments{});
+  edges = add_moments{}(edges, edge_moments{}(points.back(), points.front()));
+  if (edges.signed_area != 0)
+  {
+    long double scale = 3.0L * edges.signed_area;
+    return {static_cast< double >(edges.x_sum / scale), static_cast< double >(edges.y_sum / scale)};
+  }
+  // degenerate polygons have no area centroid, so the vertexes are averaged instead
+  moments vertexes = std::accumulate(points.begin(), points.end(), moments{0, 0, 0}, add_vertex{});
+  long double count = points.size();
+  return {static_cast< double >(vertexes.x_sum / count), static_cast< double >(vertexes.y_sum / count)};
+}
+
+rychkov::CentroidTree::CentroidTree(const std::vector< Polygon >& polygons)
+{
+  struct append_node
+  {
+    std::vector< Node >& nodes;
+    void operator()(const Polygon& polygon) const
+    {
+      nodes.push_back({get_centroid(polygon), nodes.size()});
+    }
+  };
+  nodes_.reserve(polygons.size());
+  std::for_each(polygons.begin(), polygons.end(), append_node{nodes_});
+  build(0, nodes_.size(), true);
+}
+void rychkov::CentroidTree::build(size_t begin, size_t end, bool by_x)
+{
+  if (end - begin < 2)
+  {
+    return;
+  }
+  struct compare
+  {
+    bool by_x;
+    bool operator()(const Node& lhs, const Node& rhs) const noexcept
+    {
+      return by_x ? lhs.centroid.x < rhs.centroid.x : lhs.centroid.y < rhs.centroid.y;
+    }
+  };
+  size_t mid = begin + (end - begin) / 2;
+  std::nth_element(nodes_.begin() + begin, nodes_.begin() + mid, nodes_.begin() + end, compare{by_x});
+  build(begin, mid, !by_x);
+  build(mid + 1, end, !by_x);
+}
+size_t rychkov::CentroidTree::size() const noexcept
+{
+  return nodes_.size();
+}
+std::vector< size_t > rychkov::CentroidTree::nearest(size_t count, const Point& point) const
+{
+  search_state state{{static_cast< double >(point.x), static_cast< double >(point.y)}, count, {}};
+  state.best.reserve(std::min(count, nodes_.size()));
+  search(state, 0, nodes_.size(), true, 0.0);
+  std::sort_heap(state.best.begin(), state.best.end());
+  std::vector< size_t > result(state.best.size());
+  std::transform(state.best.begin(), state.best.end(), result.begin(), std::mem_fn(&candidate::second));
+  return result;
+}
+void rychkov::CentroidTree::search(search_state& state, size_t begin, size_t end, bool by_x,
+      double plane_distance) const
+{
+  if ((begin == end) || !state.worth_visiting(plane_distance))
+  {
+    return;
+  }
+  size_t mid = begin + (end - begin) / 2;
+  const Node& node = nodes_[mid];
+  state.offer({squared_distance(node.centroid, state.target), node.id});
+  double split_distance = by_x ? state.target.x - node.centroid.x : state.target.y - node.centroid.y;
+  // the near half goes first and keeps the parent's bound, so the far half is often pruned
+  if (split_distance < 0)
+  {
+    search(state, begin, mid, !by_x, plane_distance);
+    search(state, mid + 1, end, !by_x, split_distance);
+  }
+  else
+  {
+    search(state, mid + 1, end, !by_x, plane_distance);
+    search(state, begin, mid, !by_x, split_distance);
+  }
+}
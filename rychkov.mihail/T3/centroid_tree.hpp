@@ -0,0 +1,40 @@
+#ifndef CENTROID_TREE_HPP
+#define CENTROID_TREE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "polygon.hpp"
+
+namespace rychkov
+{
+  struct Centroid
+  {
+    double x, y;
+  };
+  Centroid get_centroid(const Polygon& polygon) noexcept;
+
+  class CentroidTree
+  {
+  public:
+    CentroidTree() = default;
+    explicit CentroidTree(const std::vector< Polygon >& polygons);
+
+    size_t size() const noexcept;
+    std::vector< size_t > nearest(size_t count, const Point& point) const;
+  private:
+    struct Node
+    {
+      Centroid centroid;
+      size_t id;
+    };
+    // implicit layout: subrange [begin, end) keeps its splitter in the middle,
+    // the left half in [begin, mid) and the right half in (mid, end)
+    std::vector< Node > nodes_;
+    struct search_state;
+
+    void build(size_t begin, size_t end, bool by_x);
+    void search(search_state& state, size_t begin, size_t end, bool by_x, double plane_distance) const;
+  };
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef COMMAND_TABLE_HPP
+#define COMMAND_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <locale>
+#include <utility>
+
+namespace rychkov
+{
+  struct ParserContext;
+  namespace command_hash
+  {
+    static constexpr size_t max_token_length = 32;
+    static constexpr std::uint32_t max_seed = 1 << 16;
+
+    constexpr std::uint32_t step(std::uint32_t hash, char c) noexcept
+    {
+      return (hash ^ static_cast< unsigned char >(c)) * 16777619U;
+    }
+    constexpr size_t length(const char* name) noexcept
+    {
+      size_t result = 0;
+      while (name[result] != '\0')
+      {
+        result++;
+      }
+      return result;
+    }
+    constexpr std::uint32_t hash(std::uint32_t seed, const char* name) noexcept
+    {
+      for (; *name != '\0'; name++)
+      {
+        seed = step(seed, *name);
+      }
+      return seed;
+    }
+    constexpr size_t slots_for(size_t count) noexcept
+    {
+      size_t result = 1;
+      while (result < 2 * count)
+      {
+        result <<= 1;
+      }
+      return result;
+    }
+  }
+
+  template< class Proc >
+  struct Command
+  {
+    const char* name;
+    bool (Proc::*call)(ParserContext&);
+  };
+
+  // Perfect-hash dispatch table over a fixed command list. The seed is searched
+  // at compile time so that every name lands in its own slot; lookup hashes the
+  // token while it is being read and does a single comparison.
+  template< class Proc, size_t N >
+  class CommandTable
+  {
+  public:
+    static_assert(N > 0, "command table must not be empty");
+    static_assert(N < 256, "command table is too large");
+    static constexpr size_t slots = command_hash::slots_for(N);
+
+    constexpr CommandTable(const Command< Proc > (&commands)[N]):
+      CommandTable(commands, std::make_index_sequence< N >{})
+    {}
+
+    constexpr bool valid() const noexcept
+    {
+      return valid_;
+    }
+    const Command< Proc >* read(std::istream& in) const
+    {
+      std::istream::sentry sentry(in);
+      if (!sentry)
+      {
+        return nullptr;
+      }
+      const std::ctype< char >& ctype = std::use_facet< std::ctype< char > >(in.getloc());
+      std::streambuf* buf = in.rdbuf();
+      char token[command_hash::max_token_length];
+      size_t length = 0;
+      std::uint32_t hash = seed_;
+      std::istream::int_type c = buf->sgetc();
+      while (!std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof()))
+      {
+        char ch = std::istream::traits_type::to_char_type(c);
+        if (ctype.is(std::ctype_base::space, ch))
+        {
+          break;
+        }
+        if (length < command_hash::max_token_length)
+        {
+          token[length] = ch;
+        }
+        hash = command_hash::step(hash, ch);
+        length++;
+        c = buf->snextc();
+      }
+      if (std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof()))
+      {
+        in.setstate(std::ios::eofbit);
+      }
+      if (length == 0)
+      {
+        in.setstate(std::ios::failbit);
+        return nullptr;
+      }
+      size_t slot = slots_[hash & (slots - 1)];
+      if ((slot == 0) || (lengths_[slot - 1] != length))
+      {
+        return &unknown_;
+      }
+      const char* name = commands_[slot - 1].name;
+      for (size_t i = 0; i < length; i++)
+      {
+        if (name[i] != token[i])
+        {
+          return &unknown_;
+        }
+      }
+      return &commands_[slot - 1];
+    }
+  private:
+    Command< Proc > commands_[N];
+    size_t lengths_[N];
+    unsigned char slots_[slots];
+    std::uint32_t seed_;
+    bool valid_;
+    Command< Proc > unknown_;
+
+    template< size_t... I >
+    constexpr CommandTable(const Command< Proc > (&commands)[N], std::index_sequence< I... >):
+      commands_{commands[I]...},
+      lengths_{command_hash::length(commands[I].name)...},
+      slots_{},
+      seed_(2166136261U),
+      valid_(false),
+      unknown_{"", nullptr}
+    {
+      for (size_t i = 0; i < N; i++)
+      {
+        if (lengths_[i] > command_hash::max_token_length)
+        {
+          return;
+        }
+      }
+      for (std::uint32_t attempt = 0; attempt < command_hash::max_seed; attempt++, seed_++)
+      {
+        for (size_t i = 0; i < slots; i++)
+        {
+          slots_[i] = 0;
+        }
+        size_t placed = 0;
+        for (; placed < N; placed++)
+        {
+          size_t slot = command_hash::hash(seed_, commands_[placed].name) & (slots - 1);
+          if (slots_[slot] != 0)
+          {
+            break;
+          }
+          slots_[slot] = static_cast< unsigned char >(placed + 1);
+        }
+        if (placed == N)
+        {
+          valid_ = true;
+          return;
+        }
+      }
+    }
+  };
+}
+
+#endif
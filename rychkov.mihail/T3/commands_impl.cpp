@@ -6,6 +6,7 @@
 #include <functional>
 #include <vector>
 #include <stdexcept>
+#include "area_kernel.hpp"
 
 namespace rychkov
 {
@@ -194,7 +195,11 @@ bool rychkov::MainProcessor::remove_repeates(ParserContext& context)
     }
   };
   decltype(polygons_)::iterator new_end = std::unique(polygons_.begin(), polygons_.end(), equal{});
-  polygons_.erase(new_end, polygons_.end());
+  if (new_end != polygons_.end())
+  {
+    polygons_.erase(new_end, polygons_.end());
+    centroids_ = CentroidTree{polygons_};
+  }
   return true;
 }
 bool rychkov::MainProcessor::rectangles(ParserContext& context)
@@ -221,23 +226,28 @@ bool rychkov::MainProcessor::rectangles(ParserContext& context)
   context.out << std::count_if(polygons_.begin(), polygons_.end(), is_rect{}) << '\n';
   return true;
 }
-double rychkov::get_area::operator()(const Polygon& polygon)
+bool rychkov::MainProcessor::nearest(ParserContext& context)
 {
-  if (polygon.points.size() < 3)
+  size_t count = parse_as_count(context);
+  Point point;
+  if ((count == 0) || (count == ~0ULL) || (count > centroids_.size()) || !(context.in >> point) || !eol(context.in))
   {
-    return 0;
+    return false;
   }
-  using namespace std::placeholders;
-  area_accumulator accumulator;
-  std::vector< double > temp(polygon.points.size(), 0);
-  temp[0] = accumulator(polygon.points.back(), polygon.points.front());
-  std::transform(polygon.points.begin(), std::prev(polygon.points.end()), std::next(polygon.points.begin()),
-        std::next(temp.begin()), accumulator);
-  double result = std::accumulate(temp.begin(), temp.end(), 0.0) / 2;
-  return (result < 0 ? -result : result);
-}
-double rychkov::area_accumulator::operator()(const Point& prev, const Point& cur)
-{
-  double result = prev.x * cur.y - cur.x * prev.y;
-  return result;
+  struct area_by_id
+  {
+    const std::vector< Polygon >& polygons;
+    double operator()(size_t id) const
+    {
+      return get_area{}(polygons[id]);
+    }
+  };
+  std::vector< size_t > ids = centroids_.nearest(count, point);
+  std::transform(ids.begin(), ids.end(), outbuf_joiner< double >{context.out, " "}, area_by_id{polygons_});
+  context.out << '\n';
+  return true;
+}
+double rychkov::get_area::operator()(const Polygon& polygon)
+{
+  return doubled_area(polygon) / 2.0;
 }
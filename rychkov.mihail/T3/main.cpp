@@ -1,20 +1,35 @@
 #include <iostream>
-#include <iomanip>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdio>
+#include <outbuf.hpp>
 #include "parser.hpp"
 #include "processors.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
 int main(int argc, char** argv)
 {
-  std::cout << std::fixed << std::setprecision(1);
   try
   {
     rychkov::MainProcessor processor{argc, argv};
 
-    rychkov::ParserContext context{std::cin, std::cout, std::cerr};
+    rychkov::outbuf out{stdout, 1};
+    rychkov::ParserContext context{std::cin, out, std::cerr};
+#if defined(__unix__) || defined(__APPLE__)
+    bool interactive = isatty(STDIN_FILENO);
+#else
+    bool interactive = true;
+#endif
     while (rychkov::Parser::parse(context, processor, rychkov::MainProcessor::call_map))
-    {}
+    {
+      if (interactive)
+      {
+        out.flush();
+      }
+    }
   }
   catch (const std::invalid_argument& e)
   {
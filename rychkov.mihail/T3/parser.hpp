@@ -3,10 +3,10 @@
 
 #include <iosfwd>
 #include <istream>
-#include <string>
 #include <utility>
-#include <map>
 #include <limits>
+#include <outbuf.hpp>
+#include "command_table.hpp"
 
 namespace rychkov
 {
@@ -14,7 +14,7 @@ namespace rychkov
   struct ParserContext
   {
     std::istream& in;
-    std::ostream& out;
+    outbuf& out;
     std::ostream& err;
 
     void parse_error();
@@ -23,23 +23,22 @@ namespace rychkov
   {
     template< class Proc >
     using call_signature = bool(Proc::*)(ParserContext&);
-    template< class Proc >
-    using map_type = std::map< std::string, call_signature< Proc > >;
+    template< class Proc, size_t N >
+    using table_type = CommandTable< Proc, N >;
 
-    template< class Proc >
-    static bool parse(ParserContext context, Proc& processor, const map_type< Proc >& call_map)
+    template< class Proc, size_t N >
+    static bool parse(ParserContext context, Proc& processor, const table_type< Proc, N >& call_map)
     {
-      if (call_map.empty() || !context.in)
+      if (!context.in)
       {
         return false;
       }
-      std::string command;
-      if (context.in >> command)
+      const Command< Proc >* command = call_map.read(context.in);
+      if (command != nullptr)
       {
-        typename map_type< Proc >::const_iterator call_p = call_map.find(command);
         try
         {
-          if ((call_p != call_map.end()) && ((processor.*(call_p->second))(context)))
+          if ((command->call != nullptr) && ((processor.*(command->call))(context)))
           {
             return true;
           }
@@ -7,31 +7,37 @@
 #include <stdexcept>
 #include <limits>
 
-rychkov::Parser::map_type< rychkov::MainProcessor > rychkov::MainProcessor::call_map = {
+constexpr decltype(rychkov::MainProcessor::call_map) rychkov::MainProcessor::call_map = {{
       {"AREA", &rychkov::MainProcessor::area},
       {"MAX", &rychkov::MainProcessor::max},
       {"MIN", &rychkov::MainProcessor::min},
       {"COUNT", &rychkov::MainProcessor::count},
       {"RMECHO", &rychkov::MainProcessor::remove_repeates},
-      {"RECTS", &rychkov::MainProcessor::rectangles}
-    };
-rychkov::Parser::map_type< rychkov::AreaProcessor > rychkov::AreaProcessor::call_map = {
+      {"RECTS", &rychkov::MainProcessor::rectangles},
+      {"NEAREST", &rychkov::MainProcessor::nearest}
+    }};
+static_assert(rychkov::MainProcessor::call_map.valid(), "no perfect hash for MainProcessor commands");
+constexpr decltype(rychkov::AreaProcessor::call_map) rychkov::AreaProcessor::call_map = {{
       {"EVEN", &rychkov::AreaProcessor::even},
       {"ODD", &rychkov::AreaProcessor::odd},
       {"MEAN", &rychkov::AreaProcessor::mean}
-    };
-rychkov::Parser::map_type< rychkov::MaxProcessor > rychkov::MaxProcessor::call_map = {
+    }};
+static_assert(rychkov::AreaProcessor::call_map.valid(), "no perfect hash for AreaProcessor commands");
+constexpr decltype(rychkov::MaxProcessor::call_map) rychkov::MaxProcessor::call_map = {{
       {"AREA", &rychkov::MaxProcessor::area},
       {"VERTEXES", &rychkov::MaxProcessor::count}
-    };
-rychkov::Parser::map_type< rychkov::MinProcessor > rychkov::MinProcessor::call_map = {
+    }};
+static_assert(rychkov::MaxProcessor::call_map.valid(), "no perfect hash for MaxProcessor commands");
+constexpr decltype(rychkov::MinProcessor::call_map) rychkov::MinProcessor::call_map = {{
       {"AREA", &rychkov::MinProcessor::area},
       {"VERTEXES", &rychkov::MinProcessor::count}
-    };
-rychkov::Parser::map_type< rychkov::CountProcessor > rychkov::CountProcessor::call_map = {
+    }};
+static_assert(rychkov::MinProcessor::call_map.valid(), "no perfect hash for MinProcessor commands");
+constexpr decltype(rychkov::CountProcessor::call_map) rychkov::CountProcessor::call_map = {{
       {"EVEN", &rychkov::CountProcessor::even},
       {"ODD", &rychkov::CountProcessor::odd}
-    };
+    }};
+static_assert(rychkov::CountProcessor::call_map.valid(), "no perfect hash for CountProcessor commands");
 
 rychkov::MainProcessor::MainProcessor(int argc, char** argv)
 {
@@ -51,6 +57,7 @@ rychkov::MainProcessor::MainProcessor(int argc, char** argv)
     file.clear(file.rdstate() & ~std::ios::failbit);
     file.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
   }
+  centroids_ = CentroidTree{polygons_};
 }
 rychkov::AreaProcessor::AreaProcessor(std::vector< Polygon >& polygons) noexcept:
   polygons_(polygons)
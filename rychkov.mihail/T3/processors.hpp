@@ -3,13 +3,14 @@
 
 #include "parser.hpp"
 #include "polygon.hpp"
+#include "centroid_tree.hpp"
 
 namespace rychkov
 {
   class MainProcessor
   {
   public:
-    static Parser::map_type< MainProcessor > call_map;
+    static const Parser::table_type< MainProcessor, 7 > call_map;
 
     MainProcessor(int argc, char** argv);
 
@@ -19,13 +20,15 @@ namespace rychkov
     bool count(ParserContext& context);
     bool remove_repeates(ParserContext& context);
     bool rectangles(ParserContext& context);
+    bool nearest(ParserContext& context);
   private:
     std::vector< Polygon > polygons_;
+    CentroidTree centroids_;
   };
   class AreaProcessor
   {
   public:
-    static Parser::map_type< AreaProcessor > call_map;
+    static const Parser::table_type< AreaProcessor, 3 > call_map;
 
     AreaProcessor(std::vector< Polygon >& polygons) noexcept;
     bool even(ParserContext& context);
@@ -38,7 +41,7 @@ namespace rychkov
   class MaxProcessor
   {
   public:
-    static Parser::map_type< MaxProcessor > call_map;
+    static const Parser::table_type< MaxProcessor, 2 > call_map;
 
     MaxProcessor(std::vector< Polygon >& polygons) noexcept;
     bool area(ParserContext& context);
@@ -49,7 +52,7 @@ namespace rychkov
   class MinProcessor
   {
   public:
-    static Parser::map_type< MinProcessor > call_map;
+    static const Parser::table_type< MinProcessor, 2 > call_map;
 
     MinProcessor(std::vector< Polygon >& polygons) noexcept;
     bool area(ParserContext& context);
@@ -60,7 +63,7 @@ namespace rychkov
   class CountProcessor
   {
   public:
-    static Parser::map_type< CountProcessor > call_map;
+    static const Parser::table_type< CountProcessor, 2 > call_map;
 
     CountProcessor(std::vector< Polygon >& polygons) noexcept;
     bool even(ParserContext& context);
@@ -74,10 +77,6 @@ namespace rychkov
   {
     double operator()(const Polygon& polygon);
   };
-  struct area_accumulator
-  {
-    double operator()(const Point& prev, const Point& cur);
-  };
   template< class T >
   struct if_statement
   {
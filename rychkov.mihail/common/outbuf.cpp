@@ -0,0 +1,177 @@
+#include "outbuf.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RYCHKOV_OUTBUF_POSIX
+#include <unistd.h>
+#endif
+
+namespace
+{
+  constexpr int max_fast_precision = 9;
+  constexpr double fast_limit = 9e15;
+  constexpr double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+  constexpr unsigned long long integer_powers_of_ten[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL,
+        100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+      };
+}
+
+rychkov::outbuf::outbuf(std::FILE* file, int precision, size_t capacity):
+  file_(file),
+  precision_(precision < 0 ? 0 : precision),
+  capacity_(capacity < 512 ? 512 : capacity),
+  size_(0),
+  good_(true),
+  buffer_(new char[capacity_])
+{}
+rychkov::outbuf::~outbuf()
+{
+  flush();
+}
+
+bool rychkov::outbuf::write_out(const char* data, size_t length)
+{
+#ifdef RYCHKOV_OUTBUF_POSIX
+  int fd = fileno(file_);
+  while (length != 0)
+  {
+    ssize_t written = ::write(fd, data, length);
+    if (written < 0)
+    {
+      if (errno != EINTR)
+      {
+        return false;
+      }
+      continue;
+    }
+    data += written;
+    length -= written;
+  }
+  return true;
+#else
+  return (std::fwrite(data, 1, length, file_) == length) && (std::fflush(file_) == 0);
+#endif
+}
+bool rychkov::outbuf::flush()
+{
+  if (good_ && (size_ != 0))
+  {
+    good_ = write_out(buffer_.get(), size_);
+  }
+  size_ = 0;
+  return good_;
+}
+bool rychkov::outbuf::good() const noexcept
+{
+  return good_;
+}
+char* rychkov::outbuf::reserve(size_t length)
+{
+  if (capacity_ - size_ < length)
+  {
+    flush();
+  }
+  return buffer_.get() + size_;
+}
+void rychkov::outbuf::put(char c)
+{
+  *reserve(1) = c;
+  size_++;
+}
+
+rychkov::outbuf& rychkov::outbuf::operator<<(char c)
+{
+  put(c);
+  return *this;
+}
+rychkov::outbuf& rychkov::outbuf::operator<<(const char* str)
+{
+  size_t length = std::strlen(str);
+  while (length != 0)
+  {
+    size_t part = std::min(length, capacity_);
+    std::memcpy(reserve(part), str, part);
+    size_ += part;
+    str += part;
+    length -= part;
+  }
+  return *this;
+}
+void rychkov::outbuf::write_unsigned(unsigned long long value)
+{
+  char digits[20];
+  char* begin = digits + sizeof(digits);
+  do
+  {
+    *--begin = '0' + value % 10;
+    value /= 10;
+  }
+  while (value != 0);
+  size_t length = digits + sizeof(digits) - begin;
+  std::memcpy(reserve(length), begin, length);
+  size_ += length;
+}
+bool rychkov::outbuf::write_fast_fixed(double value)
+{
+  if (!std::isfinite(value) || (precision_ > max_fast_precision))
+  {
+    return false;
+  }
+  double scaled = std::fabs(value) * powers_of_ten[precision_];
+  if (scaled >= fast_limit)
+  {
+    return false;
+  }
+  double whole = std::floor(scaled);
+  double fraction = scaled - whole;
+  // scaling may be off by half an ulp, so near-ties are left to the C library,
+  // which rounds the exact binary value
+  if (std::fabs(fraction - 0.5) <= (scaled + 1) * 1e-15)
+  {
+    return false;
+  }
+  unsigned long long digits = static_cast< unsigned long long >(whole) + (fraction > 0.5 ? 1 : 0);
+  if (std::signbit(value))
+  {
+    put('-');
+  }
+  write_unsigned(digits / integer_powers_of_ten[precision_]);
+  if (precision_ != 0)
+  {
+    char* dest = reserve(precision_ + 1);
+    dest[0] = '.';
+    unsigned long long decimals = digits % integer_powers_of_ten[precision_];
+    for (int i = precision_; i > 0; i--)
+    {
+      dest[i] = '0' + decimals % 10;
+      decimals /= 10;
+    }
+    size_ += precision_ + 1;
+  }
+  return true;
+}
+rychkov::outbuf& rychkov::outbuf::operator<<(double value)
+{
+  if (!write_fast_fixed(value))
+  {
+    char text[512];
+    int length = std::snprintf(text, sizeof(text), "%.*f", precision_, value);
+    if ((length > 0) && (static_cast< size_t >(length) < sizeof(text)))
+    {
+      *this << text;
+    }
+    else if (length > 0)
+    {
+      std::unique_ptr< char[] > long_text(new char[length + 1]);
+      std::snprintf(long_text.get(), length + 1, "%.*f", precision_, value);
+      *this << long_text.get();
+    }
+  }
+  return *this;
+}
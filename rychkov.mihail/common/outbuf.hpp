@@ -0,0 +1,114 @@
+#ifndef OUTBUF_HPP
+#define OUTBUF_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace rychkov
+{
+  // Output sink over a C stream. Text is formatted straight into a user-space
+  // buffer, which goes out when it fills up, on flush() and on destruction:
+  // with one write(2) on the stream's descriptor where POSIX is available and
+  // through fwrite elsewhere. Doubles are printed like std::fixed with the
+  // precision given at construction.
+  class outbuf
+  {
+  public:
+    static constexpr size_t default_capacity = 1 << 16;
+
+    explicit outbuf(std::FILE* file, int precision = 1, size_t capacity = default_capacity);
+    outbuf(const outbuf&) = delete;
+    ~outbuf();
+
+    outbuf& operator<<(char c);
+    outbuf& operator<<(const char* str);
+    outbuf& operator<<(double value);
+    template< class T >
+    std::enable_if_t< std::is_integral< T >::value && std::is_unsigned< T >::value, outbuf& > operator<<(T value)
+    {
+      write_unsigned(value);
+      return *this;
+    }
+    template< class T >
+    std::enable_if_t< std::is_integral< T >::value && std::is_signed< T >::value, outbuf& > operator<<(T value)
+    {
+      if (value < 0)
+      {
+        put('-');
+        write_unsigned(0ULL - static_cast< unsigned long long >(value));
+      }
+      else
+      {
+        write_unsigned(static_cast< unsigned long long >(value));
+      }
+      return *this;
+    }
+
+    bool flush();
+    bool good() const noexcept;
+  private:
+    std::FILE* file_;
+    int precision_;
+    size_t capacity_;
+    size_t size_;
+    bool good_;
+    std::unique_ptr< char[] > buffer_;
+
+    bool write_out(const char* data, size_t length);
+    char* reserve(size_t length);
+    void put(char c);
+    void write_unsigned(unsigned long long value);
+    bool write_fast_fixed(double value);
+  };
+
+  // ostream_iterator for outbuf that puts the delimiter between values
+  // rather than after each of them.
+  template< class T >
+  class outbuf_joiner
+  {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = void;
+    using pointer = void;
+    using reference = void;
+
+    outbuf_joiner(outbuf& out, const char* delimiter):
+      out_(&out),
+      delimiter_(delimiter),
+      first_(true)
+    {}
+
+    outbuf_joiner& operator=(const T& value)
+    {
+      if (!first_)
+      {
+        *out_ << delimiter_;
+      }
+      first_ = false;
+      *out_ << value;
+      return *this;
+    }
+    outbuf_joiner& operator*() noexcept
+    {
+      return *this;
+    }
+    outbuf_joiner& operator++() noexcept
+    {
+      return *this;
+    }
+    outbuf_joiner& operator++(int) noexcept
+    {
+      return *this;
+    }
+  private:
+    outbuf* out_;
+    const char* delimiter_;
+    bool first_;
+  };
+}
+
+#endif
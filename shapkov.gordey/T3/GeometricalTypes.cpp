@@ -31,6 +31,12 @@ std::istream& shapkov::operator>>(std::istream& in, Point& point)
   return in;
 }
 
+bool shapkov::PointCollector::operator()(const Point& point) const
+{
+  points.push_back(point);
+  return points.size() == until;
+}
+
 std::ostream& shapkov::operator<<(std::ostream& out, const Point& point)
 {
   std::ostream::sentry s(out);
@@ -54,12 +60,19 @@ std::istream& shapkov::operator>>(std::istream& in, Polygon& polygon)
     in.setstate(std::ios::failbit);
     return in;
   }
-  std::vector< Point > points(vertexes, Point{ 0, 0 });
+  std::vector< Point > points;
+  if (vertexes > points.max_size())
+  {
+    in.setstate(std::ios::failbit);
+    return in;
+  }
+  // typical polygons fit without regrowing, while a bogus count allocates nothing up front
+  points.reserve(std::min< size_t >(vertexes, 64));
   using inputIt = std::istream_iterator< Point >;
-  std::copy_n(inputIt{ in }, vertexes, points.begin());
+  std::find_if(inputIt{ in }, inputIt{}, PointCollector{ points, vertexes });
   if (in && points.size() == vertexes)
   {
-    polygon.points = points;
+    polygon.points.swap(points);
   }
   else
   {
@@ -81,73 +94,95 @@ std::ostream& shapkov::operator<<(std::ostream& out, const Polygon& polygon)
   return out;
 }
 
+size_t shapkov::PolygonView::size() const
+{
+  return count;
+}
+
+const shapkov::Point* shapkov::PolygonView::begin() const
+{
+  return points;
+}
+
+const shapkov::Point* shapkov::PolygonView::end() const
+{
+  return points + count;
+}
+
+const shapkov::Point& shapkov::PolygonView::operator[](size_t i) const
+{
+  return points[i];
+}
+
+shapkov::PolygonView shapkov::makeView(const Polygon& p)
+{
+  return PolygonView{ p.points.data(), p.points.size() };
+}
+
 double shapkov::getDistance(const Point& p1, const Point& p2)
 {
   return std::sqrt(std::pow((p1.x - p2.x), 2) + std::pow((p1.y - p2.y), 2));
 }
 
-double shapkov::getAreaOfTriangle(const Polygon& p)
+double shapkov::getAreaOfTriangle(const Point& a, const Point& b, const Point& c)
 {
-  double sideA = getDistance(p.points[0], p.points[1]);
-  double sideB = getDistance(p.points[2], p.points[1]);
-  double sideC = getDistance(p.points[0], p.points[2]);
+  double sideA = getDistance(a, b);
+  double sideB = getDistance(c, b);
+  double sideC = getDistance(a, c);
   double halfPerimeter = (sideA + sideB + sideC) / 2;
   return std::sqrt(halfPerimeter * (halfPerimeter - sideA) * (halfPerimeter - sideB) * (halfPerimeter - sideC));
 }
 
-shapkov::Polygon shapkov::makeTriangle(size_t i, const std::vector< Point >& pts)
+double shapkov::FanTriangleArea::operator()(const Point& b, const Point& c) const
 {
-  return Polygon{ std::vector<Point>{ pts[0], pts[i + 1], pts[i + 2] } };
+  return getAreaOfTriangle(apex, b, c);
 }
 
-shapkov::Polygon shapkov::TriangleGenerator::operator()()
+double shapkov::getArea(const PolygonView& p)
 {
-  return shapkov::makeTriangle(index++, points);
-}
-
-std::vector< shapkov::Polygon > shapkov::polygonToTriangles(const Polygon& p)
-{
-  size_t size = p.points.size() - 2;
-  std::vector< Polygon > triangles(size);
-  size_t index = 0;
-  std::generate(triangles.begin(), triangles.end(), TriangleGenerator{ index, p.points });
-  return triangles;
+  if (p.size() < 3)
+  {
+    return 0.0;
+  }
+  return std::inner_product(p.begin() + 1, p.end() - 1, p.begin() + 2, 0.0, std::plus< double >{}, FanTriangleArea{ p[0] });
 }
 
-double shapkov::getArea(const Polygon& p)
+double shapkov::getPerimeter(const PolygonView& p)
 {
-  std::vector< Polygon > triangles = polygonToTriangles(p);
-  std::vector< double > areas;
-  std::transform(triangles.begin(), triangles.end(), std::back_inserter(areas), getAreaOfTriangle);
-  return std::accumulate(areas.begin(), areas.end(), 0.0);
+  if (p.size() < 2)
+  {
+    return 0.0;
+  }
+  double sides = std::inner_product(p.begin(), p.end() - 1, p.begin() + 1, 0.0, std::plus< double >{}, getDistance);
+  return sides + getDistance(p[p.size() - 1], p[0]);
 }
 
-bool shapkov::isEven(const Polygon& p)
+bool shapkov::isEven(const PolygonView& p)
 {
-  return p.points.size() != 0 && p.points.size() % 2 == 0;
+  return p.size() != 0 && p.size() % 2 == 0;
 }
 
-bool shapkov::isOdd(const Polygon& p)
+bool shapkov::isOdd(const PolygonView& p)
 {
-  return p.points.size() != 0 && p.points.size() % 2 != 0;
+  return p.size() != 0 && p.size() % 2 != 0;
 }
 
-bool shapkov::compareByVertexes(const Polygon& p1, const Polygon& p2)
+bool shapkov::compareByVertexes(const PolygonView& p1, const PolygonView& p2)
 {
-  return p1.points.size() < p2.points.size();
+  return p1.size() < p2.size();
 }
 
-bool shapkov::isRectangle(const Polygon& p)
+bool shapkov::isRectangle(const PolygonView& p)
 {
-  if (p.points.size() != 4)
+  if (p.size() != 4)
   {
     return false;
   }
-  double sideA = getDistance(p.points[0], p.points[1]);
-  double sideB = getDistance(p.points[2], p.points[1]);
-  double sideC = getDistance(p.points[3], p.points[2]);
-  double sideD = getDistance(p.points[3], p.points[0]);
-  double diagAC = getDistance(p.points[0], p.points[2]);
+  double sideA = getDistance(p[0], p[1]);
+  double sideB = getDistance(p[2], p[1]);
+  double sideC = getDistance(p[3], p[2]);
+  double sideD = getDistance(p[3], p[0]);
+  double diagAC = getDistance(p[0], p[2]);
   double diagAC1 = std::sqrt(std::pow((sideA), 2) + std::pow((sideB), 2));
   return (compareDouble(diagAC, diagAC1) && compareDouble(sideA, sideC) && compareDouble(sideB, sideD));
 }
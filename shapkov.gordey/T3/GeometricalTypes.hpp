@@ -13,25 +13,39 @@ namespace shapkov
   {
     std::vector< Point > points;
   };
+  struct PolygonView
+  {
+    const Point* points;
+    size_t count;
+    size_t size() const;
+    const Point* begin() const;
+    const Point* end() const;
+    const Point& operator[](size_t i) const;
+  };
+  PolygonView makeView(const Polygon& p);
+  struct PointCollector
+  {
+    std::vector< Point >& points;
+    size_t until;
+    bool operator()(const Point& point) const;
+  };
   std::istream& operator>>(std::istream& in, Point& point);
   std::ostream& operator<<(std::ostream& out, const Point& point);
   std::istream& operator>>(std::istream& in, Polygon& polygon);
   std::ostream& operator<<(std::ostream& out, const Polygon& polygon);
   double getDistance(const Point& p1, const Point& p2);
-  double getAreaOfTriangle(const Polygon& p);
-  struct TriangleGenerator
+  double getAreaOfTriangle(const Point& a, const Point& b, const Point& c);
+  struct FanTriangleArea
   {
-    size_t& index;
-    const std::vector< Point >& points;
-    shapkov::Polygon operator()();
+    const Point& apex;
+    double operator()(const Point& b, const Point& c) const;
   };
-  Polygon makeTriangle(size_t i, const std::vector< Point >& pts);
-  std::vector< Polygon > polygonToTriangles(const Polygon& p);
-  double getArea(const Polygon& p);
-  bool isEven(const Polygon& p);
-  bool isOdd(const Polygon& p);
-  bool compareByVertexes(const Polygon& p1, const Polygon& p2);
-  bool isRectangle(const Polygon& p);
+  double getArea(const PolygonView& p);
+  double getPerimeter(const PolygonView& p);
+  bool isEven(const PolygonView& p);
+  bool isOdd(const PolygonView& p);
+  bool compareByVertexes(const PolygonView& p1, const PolygonView& p2);
+  bool isRectangle(const PolygonView& p);
 }
 
 #endif
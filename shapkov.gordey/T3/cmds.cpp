@@ -6,12 +6,90 @@
 #include <iterator>
 #include <iomanip>
 #include <unordered_map>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <scopeGuard.hpp>
 #include "polygonfunctors.hpp"
 
 using namespace std::placeholders;
 
-void shapkov::areaEven(std::ostream& out, const VecOfPolygons& src)
+namespace
+{
+  using shapkov::CmdStatus;
+  using shapkov::VecOfPolygons;
+  using SubCmd = CmdStatus (*)(std::ostream&, const VecOfPolygons&);
+  using SubCmdTable = std::unordered_map< std::string, SubCmd >;
+
+  const SubCmdTable areaCmds = {
+    { "EVEN", shapkov::areaEven },
+    { "ODD", shapkov::areaOdd },
+    { "MEAN", shapkov::areaMean }
+  };
+  const SubCmdTable maxCmds = {
+    { "AREA", shapkov::maxArea },
+    { "VERTEXES", shapkov::maxVertexes }
+  };
+  const SubCmdTable minCmds = {
+    { "AREA", shapkov::minArea },
+    { "VERTEXES", shapkov::minVertexes }
+  };
+  const SubCmdTable countCmds = {
+    { "EVEN", shapkov::countEven },
+    { "ODD", shapkov::countOdd }
+  };
+
+  bool parseVertexes(const std::string& str, size_t& vertexes)
+  {
+    // the same acceptance rules as std::stoi, reported through the return value
+    const char* begin = str.c_str();
+    char* end = nullptr;
+    int savedErrno = errno;
+    errno = 0;
+    long value = std::strtol(begin, &end, 10);
+    bool inRange = errno != ERANGE && value >= INT_MIN && value <= INT_MAX;
+    errno = savedErrno;
+    if (end == begin || !inRange)
+    {
+      return false;
+    }
+    vertexes = static_cast< size_t >(static_cast< int >(value));
+    return true;
+  }
+
+  CmdStatus runSubcommand(const SubCmdTable& table, std::istream& in, std::ostream& out, const VecOfPolygons& src)
+  {
+    std::string subcommand;
+    in >> subcommand;
+    SubCmdTable::const_iterator cmd = table.find(subcommand);
+    if (cmd == table.end())
+    {
+      return CmdStatus::unknownCommand;
+    }
+    return cmd->second(out, src);
+  }
+
+  using VertexesCmd = CmdStatus (*)(std::ostream&, const VecOfPolygons&, size_t);
+  CmdStatus runSubcommandOrVertexes(const SubCmdTable& table, VertexesCmd byVertexes, std::istream& in,
+      std::ostream& out, const VecOfPolygons& src)
+  {
+    std::string subcommand;
+    in >> subcommand;
+    SubCmdTable::const_iterator cmd = table.find(subcommand);
+    if (cmd != table.end() && cmd->second(out, src) == CmdStatus::ok)
+    {
+      return CmdStatus::ok;
+    }
+    size_t vertexes = 0;
+    if (!parseVertexes(subcommand, vertexes))
+    {
+      return CmdStatus::unknownCommand;
+    }
+    return byVertexes(out, src, vertexes);
+  }
+}
+
+shapkov::CmdStatus shapkov::areaEven(std::ostream& out, const VecOfPolygons& src)
 {
   VecOfPolygons evenPolygons;
   std::copy_if(src.begin(), src.end(), std::back_inserter(evenPolygons), isEven);
@@ -19,8 +97,9 @@ void shapkov::areaEven(std::ostream& out, const VecOfPolygons& src)
   std::transform(evenPolygons.begin(), evenPolygons.end(), areas.begin(), getArea);
   double area = std::accumulate(areas.begin(), areas.end(), 0.0);
   out << std::fixed << std::setprecision(1) << area << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::areaOdd(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::areaOdd(std::ostream& out, const VecOfPolygons& src)
 {
   VecOfPolygons oddPolygons;
   std::copy_if(src.begin(), src.end(), std::back_inserter(oddPolygons), isOdd);
@@ -28,23 +107,25 @@ void shapkov::areaOdd(std::ostream& out, const VecOfPolygons& src)
   std::transform(oddPolygons.begin(), oddPolygons.end(), areas.begin(), getArea);
   double area = std::accumulate(areas.begin(), areas.end(), 0.0);
   out << std::fixed << std::setprecision(1) << area << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::areaMean(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::areaMean(std::ostream& out, const VecOfPolygons& src)
 {
   if (src.empty())
   {
-    throw std::logic_error("no polygons");
+    return CmdStatus::noPolygons;
   }
   std::vector< double > areas(src.size());
   std::transform(src.begin(), src.end(), areas.begin(), getArea);
   double area = std::accumulate(areas.begin(), areas.end(), 0.0) / src.size();
   out << std::fixed << std::setprecision(1) << area << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::areaVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes)
+shapkov::CmdStatus shapkov::areaVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes)
 {
   if (vertexes < 3)
   {
-    throw std::logic_error("wrong number of vertexes");
+    return CmdStatus::wrongVertexes;
   }
   VecOfPolygons polygons;
   std::copy_if(src.begin(), src.end(), std::back_inserter(polygons), std::bind(isSize, _1, vertexes));
@@ -52,119 +133,92 @@ void shapkov::areaVertexes(std::ostream& out, const VecOfPolygons& src, size_t v
   std::transform(polygons.begin(), polygons.end(), areas.begin(), getArea);
   double area = std::accumulate(areas.begin(), areas.end(), 0.0);
   out << std::fixed << std::setprecision(1) << area << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::area(std::istream& in, std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::area(std::istream& in, std::ostream& out, const VecOfPolygons& src)
 {
-  std::unordered_map< std::string, std::function< void() > > areaCmds;
-  areaCmds["EVEN"] = std::bind(areaEven, std::ref(out), std::cref(src));
-  areaCmds["ODD"] = std::bind(areaOdd, std::ref(out), std::cref(src));
-  areaCmds["MEAN"] = std::bind(areaMean, std::ref(out), std::cref(src));
   ScopeGuard scopeGuard(out);
-  std::string subcommand;
-  in >> subcommand;
-  try
-  {
-    areaCmds.at(subcommand)();
-  }
-  catch (...)
-  {
-    size_t vertexes = std::stoi(subcommand);
-    areaVertexes(out, src, vertexes);
-  }
+  return runSubcommandOrVertexes(areaCmds, areaVertexes, in, out, src);
 }
-void shapkov::maxArea(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::maxArea(std::ostream& out, const VecOfPolygons& src)
 {
   std::vector< double > areas(src.size());
   std::transform(src.begin(), src.end(), areas.begin(), getArea);
   out << std::fixed << std::setprecision(1) << (*std::max_element(areas.begin(), areas.end())) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::maxVertexes(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::maxVertexes(std::ostream& out, const VecOfPolygons& src)
 {
-  out << (std::max_element(src.begin(), src.end(), compareByVertexes)->points.size()) << '\n';
+  out << (std::max_element(src.begin(), src.end(), compareByVertexes)->size()) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::max(std::istream& in, std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::max(std::istream& in, std::ostream& out, const VecOfPolygons& src)
 {
   if (src.empty())
   {
-    throw std::logic_error("no polygons");
+    return CmdStatus::noPolygons;
   }
-  std::unordered_map< std::string, std::function< void() > > maxCmds;
-  maxCmds["AREA"] = std::bind(maxArea, std::ref(out), std::cref(src));
-  maxCmds["VERTEXES"] = std::bind(maxVertexes, std::ref(out), std::cref(src));
   ScopeGuard scopeGuard(out);
-  std::string subcommand;
-  in >> subcommand;
-  maxCmds.at(subcommand)();
+  return runSubcommand(maxCmds, in, out, src);
 }
-void shapkov::minArea(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::minArea(std::ostream& out, const VecOfPolygons& src)
 {
   std::vector< double > areas(src.size());
   std::transform(src.begin(), src.end(), areas.begin(), getArea);
   out << std::fixed << std::setprecision(1) << (*std::min_element(areas.begin(), areas.end())) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::minVertexes(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::minVertexes(std::ostream& out, const VecOfPolygons& src)
 {
-  out << (std::min_element(src.begin(), src.end(), compareByVertexes)->points.size()) << '\n';
+  out << (std::min_element(src.begin(), src.end(), compareByVertexes)->size()) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::min(std::istream& in, std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::min(std::istream& in, std::ostream& out, const VecOfPolygons& src)
 {
   if (src.empty())
   {
-    throw std::logic_error("no polygons");
+    return CmdStatus::noPolygons;
   }
-  std::unordered_map< std::string, std::function< void() > > minCmds;
-  minCmds["AREA"] = std::bind(minArea, std::ref(out), std::cref(src));
-  minCmds["VERTEXES"] = std::bind(minVertexes, std::ref(out), std::cref(src));
   ScopeGuard scopeGuard(out);
-  std::string subcommand;
-  in >> subcommand;
-  minCmds.at(subcommand)();
+  return runSubcommand(minCmds, in, out, src);
 }
-void shapkov::countEven(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::countEven(std::ostream& out, const VecOfPolygons& src)
 {
   out << std::count_if(src.begin(), src.end(), isEven) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::countOdd(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::countOdd(std::ostream& out, const VecOfPolygons& src)
 {
   out << std::count_if(src.begin(), src.end(), isOdd) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::countVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes)
+shapkov::CmdStatus shapkov::countVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes)
 {
   if (vertexes < 3)
   {
-    throw std::logic_error("wrong number of vertexes");
+    return CmdStatus::wrongVertexes;
   }
   out << std::count_if(src.begin(), src.end(), std::bind(isSize, _1, vertexes)) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::count(std::istream& in, std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::count(std::istream& in, std::ostream& out, const VecOfPolygons& src)
 {
-  std::unordered_map< std::string, std::function< void() > > countCmds;
-  countCmds["EVEN"] = std::bind(countEven, std::ref(out), std::cref(src));
-  countCmds["ODD"] = std::bind(countOdd, std::ref(out), std::cref(src));
   ScopeGuard scopeGuard(out);
-  std::string subcommand;
-  in >> subcommand;
-  try
-  {
-    countCmds.at(subcommand)();
-  }
-  catch (...)
-  {
-    size_t vertexes = std::stoi(subcommand);
-    countVertexes(out, src, vertexes);
-  }
+  return runSubcommandOrVertexes(countCmds, countVertexes, in, out, src);
 }
-void shapkov::rects(std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::rects(std::ostream& out, const VecOfPolygons& src)
 {
   out << std::count_if(src.begin(), src.end(), isRectangle) << '\n';
+  return CmdStatus::ok;
 }
-void shapkov::same(std::istream& in, std::ostream& out, const VecOfPolygons& src)
+shapkov::CmdStatus shapkov::same(std::istream& in, std::ostream& out, const VecOfPolygons& src)
 {
   Polygon polygon;
   in >> polygon;
   if (!in || in.peek() != '\n')
   {
-    throw std::logic_error("wrong polygon");
+    return CmdStatus::wrongPolygon;
   }
   out << std::count_if(src.begin(), src.end(), isSame{ polygon }) << '\n';
+  return CmdStatus::ok;
 }
@@ -6,24 +6,32 @@
 
 namespace shapkov
 {
-  using VecOfPolygons = std::vector< Polygon >;
-  void area(std::istream& in, std::ostream& out, const VecOfPolygons& src);
-  void areaEven(std::ostream& out, const VecOfPolygons& src);
-  void areaOdd(std::ostream& out, const VecOfPolygons& src);
-  void areaMean(std::ostream& out, const VecOfPolygons& src);
-  void areaVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes);
-  void max(std::istream& in, std::ostream& out, const VecOfPolygons& src);
-  void maxArea(std::ostream& out, const VecOfPolygons& src);
-  void maxVertexes(std::ostream& out, const VecOfPolygons& src);
-  void min(std::istream& in, std::ostream& out, const VecOfPolygons& src);
-  void minArea(std::ostream& out, const VecOfPolygons& src);
-  void minVertexes(std::ostream& out, const VecOfPolygons& src);
-  void count(std::istream& in, std::ostream& out, const VecOfPolygons& src);
-  void countEven(std::ostream& out, const VecOfPolygons& src);
-  void countOdd(std::ostream& out, const VecOfPolygons& src);
-  void countVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes);
-  void rects(std::ostream& out, const VecOfPolygons& src);
-  void same(std::istream& in, std::ostream& out, const VecOfPolygons& src);
+  using VecOfPolygons = std::vector< PolygonView >;
+  enum class CmdStatus
+  {
+    ok,
+    unknownCommand,
+    noPolygons,
+    wrongVertexes,
+    wrongPolygon
+  };
+  CmdStatus area(std::istream& in, std::ostream& out, const VecOfPolygons& src);
+  CmdStatus areaEven(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus areaOdd(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus areaMean(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus areaVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes);
+  CmdStatus max(std::istream& in, std::ostream& out, const VecOfPolygons& src);
+  CmdStatus maxArea(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus maxVertexes(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus min(std::istream& in, std::ostream& out, const VecOfPolygons& src);
+  CmdStatus minArea(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus minVertexes(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus count(std::istream& in, std::ostream& out, const VecOfPolygons& src);
+  CmdStatus countEven(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus countOdd(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus countVertexes(std::ostream& out, const VecOfPolygons& src, size_t vertexes);
+  CmdStatus rects(std::ostream& out, const VecOfPolygons& src);
+  CmdStatus same(std::istream& in, std::ostream& out, const VecOfPolygons& src);
 }
 
 #endif
@@ -1,35 +1,28 @@
+#include <algorithm>
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <iterator>
 #include <limits>
-#include <map>
+#include <unordered_map>
 #include <functional>
+#include <thread>
 #include "cmds.hpp"
 #include "GeometricalTypes.hpp"
+#include "polygonReader.hpp"
 
 int main(int argc, char* argv[])
 {
-  using shapkov::Polygon;
+  using shapkov::PolygonArena;
+  using shapkov::PolygonView;
 
   if (argc != 2)
   {
     return 1;
   }
-  std::ifstream file(argv[1]);
-  std::vector< Polygon > data;
-  using inputIt = std::istream_iterator< Polygon >;
-  while (!file.eof())
-  {
-    std::copy(inputIt{ file }, inputIt{}, std::back_inserter(data));
-    if (!file)
-    {
-      file.clear();
-      file.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
-    }
-  }
+  const PolygonArena arena = shapkov::readPolygonsParallel(argv[1], std::max(std::thread::hardware_concurrency(), 1u));
+  const std::vector< PolygonView > data = arena.views();
 
-  std::map< std::string, std::function< void() > > cmds;
+  std::unordered_map< std::string, std::function< shapkov::CmdStatus() > > cmds;
   cmds["AREA"] = std::bind(shapkov::area, std::ref(std::cin), std::ref(std::cout), std::cref(data));
   cmds["MAX"] = std::bind(shapkov::max, std::ref(std::cin), std::ref(std::cout), std::cref(data));
   cmds["MIN"] = std::bind(shapkov::min, std::ref(std::cin), std::ref(std::cout), std::cref(data));
@@ -40,11 +33,9 @@ int main(int argc, char* argv[])
   std::string command;
   while (!(std::cin >> command).eof())
   {
-    try
-    {
-      cmds.at(command)();
-    }
-    catch (...)
+    auto cmd = cmds.find(command);
+    shapkov::CmdStatus status = (cmd != cmds.end()) ? cmd->second() : shapkov::CmdStatus::unknownCommand;
+    if (status != shapkov::CmdStatus::ok)
     {
       if (std::cin.fail())
       {
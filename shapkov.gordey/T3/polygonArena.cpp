@@ -0,0 +1,49 @@
+#include "polygonArena.hpp"
+#include <algorithm>
+#include <iterator>
+
+shapkov::PolygonSlice shapkov::SliceShifter::operator()(const PolygonSlice& slice) const
+{
+  return PolygonSlice{ slice.offset + shift, slice.count };
+}
+
+shapkov::PolygonView shapkov::SliceViewer::operator()(const PolygonSlice& slice) const
+{
+  return PolygonView{ points + slice.offset, slice.count };
+}
+
+void shapkov::PolygonArena::push_back(const Polygon& p)
+{
+  slices_.push_back(PolygonSlice{ points_.size(), p.points.size() });
+  points_.insert(points_.end(), p.points.begin(), p.points.end());
+}
+
+void shapkov::PolygonArena::append(const PolygonArena& other)
+{
+  slices_.reserve(slices_.size() + other.slices_.size());
+  std::transform(other.slices_.begin(), other.slices_.end(), std::back_inserter(slices_), SliceShifter{ points_.size() });
+  points_.insert(points_.end(), other.points_.begin(), other.points_.end());
+}
+
+size_t shapkov::PolygonArena::size() const
+{
+  return slices_.size();
+}
+
+bool shapkov::PolygonArena::empty() const
+{
+  return slices_.empty();
+}
+
+shapkov::PolygonView shapkov::PolygonArena::operator[](size_t i) const
+{
+  return SliceViewer{ points_.data() }(slices_[i]);
+}
+
+std::vector< shapkov::PolygonView > shapkov::PolygonArena::views() const
+{
+  std::vector< PolygonView > result;
+  result.reserve(slices_.size());
+  std::transform(slices_.begin(), slices_.end(), std::back_inserter(result), SliceViewer{ points_.data() });
+  return result;
+}
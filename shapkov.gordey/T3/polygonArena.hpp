@@ -0,0 +1,39 @@
+#ifndef POLYGON_ARENA_HPP
+#define POLYGON_ARENA_HPP
+#include <iostream>
+#include <vector>
+#include "GeometricalTypes.hpp"
+
+namespace shapkov
+{
+  struct PolygonSlice
+  {
+    size_t offset;
+    size_t count;
+  };
+  class PolygonArena
+  {
+  public:
+    void push_back(const Polygon& p);
+    void append(const PolygonArena& other);
+    size_t size() const;
+    bool empty() const;
+    PolygonView operator[](size_t i) const;
+    std::vector< PolygonView > views() const;
+  private:
+    std::vector< Point > points_;
+    std::vector< PolygonSlice > slices_;
+  };
+  struct SliceShifter
+  {
+    size_t shift;
+    PolygonSlice operator()(const PolygonSlice& slice) const;
+  };
+  struct SliceViewer
+  {
+    const Point* points;
+    PolygonView operator()(const PolygonSlice& slice) const;
+  };
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "polygonReader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SHAPKOV_READER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+shapkov::MappedText::MappedText(const char* path):
+  data_(nullptr),
+  size_(0),
+  mapped_(false)
+{
+#ifdef SHAPKOV_READER_MMAP
+  int fd = ::open(path, O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+  {
+    void* data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      ::madvise(data, info.st_size, MADV_SEQUENTIAL);
+      data_ = static_cast< char* >(data);
+      size_ = info.st_size;
+      mapped_ = true;
+    }
+  }
+  if (fd >= 0)
+  {
+    ::close(fd);
+  }
+#endif
+  if (!mapped_)
+  {
+    std::ifstream file(path, std::ios::binary);
+    copy_.assign(std::istreambuf_iterator< char >(file), std::istreambuf_iterator< char >());
+    data_ = copy_.data();
+    size_ = copy_.size();
+  }
+}
+
+shapkov::MappedText::~MappedText()
+{
+#ifdef SHAPKOV_READER_MMAP
+  if (mapped_)
+  {
+    ::munmap(data_, size_);
+  }
+#endif
+}
+
+char* shapkov::MappedText::data() const
+{
+  return data_;
+}
+
+size_t shapkov::MappedText::size() const
+{
+  return size_;
+}
+
+shapkov::ChunkBuffer::ChunkBuffer(const MappedText& text, size_t begin)
+{
+  setg(text.data(), text.data() + begin, text.data() + text.size());
+}
+
+size_t shapkov::ChunkBuffer::position() const
+{
+  return gptr() - eback();
+}
+
+size_t shapkov::ChunkBorder::operator()()
+{
+  size_t from = std::min(last + step, text.size());
+  const void* border = std::memchr(text.data() + from, '\n', text.size() - from);
+  last = (border == nullptr) ? text.size() : static_cast< const char* >(border) - text.data() + 1;
+  return last;
+}
+
+bool shapkov::ChunkCollector::operator()(const Polygon& polygon) const
+{
+  dest.push_back(polygon);
+  return (in >> std::ws).eof() || buffer.position() >= end;
+}
+
+std::future< shapkov::PolygonChunk > shapkov::ChunkLauncher::operator()(size_t begin, size_t end) const
+{
+  return std::async(std::launch::async, readChunk, std::cref(text), begin, end);
+}
+
+void shapkov::ChunkMerger::operator()(std::future< PolygonChunk >& future) const
+{
+  PolygonChunk chunk = future.get();
+  if (chunk.begin != position)
+  {
+    chunk = readChunk(text, position, chunk.end);
+  }
+  dest.append(chunk.polygons);
+  position = chunk.finish;
+}
+
+shapkov::PolygonChunk shapkov::readChunk(const MappedText& text, size_t begin, size_t end)
+{
+  ChunkBuffer buffer(text, begin);
+  std::istream in(&buffer);
+  in >> std::ws;
+  PolygonChunk chunk{ buffer.position(), end, buffer.position(), {} };
+  using inputIt = std::istream_iterator< Polygon >;
+  while (!in.eof() && buffer.position() < end)
+  {
+    std::find_if(inputIt{ in }, inputIt{}, ChunkCollector{ chunk.polygons, in, buffer, end });
+    if (!in)
+    {
+      in.clear();
+      in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+      in >> std::ws;
+    }
+  }
+  chunk.finish = buffer.position();
+  return chunk;
+}
+
+shapkov::PolygonArena shapkov::readPolygonsParallel(const char* path, size_t threads, size_t minChunk)
+{
+  const MappedText text(path);
+  size_t chunks = std::max< size_t >(1, std::min(threads, text.size() / std::max< size_t >(minChunk, 1)));
+  std::vector< size_t > borders(chunks + 1, 0);
+  size_t last = 0;
+  std::generate(borders.begin() + 1, borders.end(), ChunkBorder{ text, text.size() / chunks, last });
+  borders.back() = text.size();
+  std::vector< std::future< PolygonChunk > > futures;
+  std::transform(borders.begin(), borders.end() - 1, borders.begin() + 1, std::back_inserter(futures), ChunkLauncher{ text });
+  PolygonArena polygons;
+  size_t position = 0;
+  std::for_each(futures.begin(), futures.end(), ChunkMerger{ text, polygons, position });
+  return polygons;
+}
@@ -0,0 +1,70 @@
+#ifndef POLYGON_READER_HPP
+#define POLYGON_READER_HPP
+#include <iostream>
+#include <future>
+#include <vector>
+#include "GeometricalTypes.hpp"
+#include "polygonArena.hpp"
+
+namespace shapkov
+{
+  class MappedText
+  {
+  public:
+    explicit MappedText(const char* path);
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+    ~MappedText();
+    char* data() const;
+    size_t size() const;
+  private:
+    char* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector< char > copy_;
+  };
+  class ChunkBuffer: public std::streambuf
+  {
+  public:
+    ChunkBuffer(const MappedText& text, size_t begin);
+    size_t position() const;
+  };
+  struct PolygonChunk
+  {
+    size_t begin;
+    size_t end;
+    size_t finish;
+    PolygonArena polygons;
+  };
+  struct ChunkBorder
+  {
+    const MappedText& text;
+    size_t step;
+    size_t& last;
+    size_t operator()();
+  };
+  struct ChunkCollector
+  {
+    PolygonArena& dest;
+    std::istream& in;
+    const ChunkBuffer& buffer;
+    size_t end;
+    bool operator()(const Polygon& polygon) const;
+  };
+  struct ChunkLauncher
+  {
+    const MappedText& text;
+    std::future< PolygonChunk > operator()(size_t begin, size_t end) const;
+  };
+  struct ChunkMerger
+  {
+    const MappedText& text;
+    PolygonArena& dest;
+    size_t& position;
+    void operator()(std::future< PolygonChunk >& future) const;
+  };
+  PolygonChunk readChunk(const MappedText& text, size_t begin, size_t end);
+  PolygonArena readPolygonsParallel(const char* path, size_t threads, size_t minChunk = 1 << 20);
+}
+
+#endif
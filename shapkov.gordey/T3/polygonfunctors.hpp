@@ -4,12 +4,12 @@
 
 namespace shapkov
 {
-  bool isSize(const Polygon& p, size_t size);
+  bool isSize(const PolygonView& p, size_t size);
   bool compareDouble(double d1, double d2, double epsilon = 1e-9);
   struct isSame
   {
     Polygon& p;
-    bool operator()(const Polygon& src) const;
+    bool operator()(const PolygonView& src) const;
   };
   struct pointDeltaSum
   {
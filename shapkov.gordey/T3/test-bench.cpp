@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "cmds.hpp"
+#include "GeometricalTypes.hpp"
+#include "polygonArena.hpp"
+
+// Microbenchmarks: make test-shapkov.gordey/T3.
+// Each one runs the current code next to a reference copy of the approach it
+// replaced and prints the best of a few runs in milliseconds. Build with -O2
+// (CXXFLAGS=-O2) for numbers worth comparing.
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr size_t benchPolygons = 200000;
+  constexpr size_t benchLines = 90000;
+  constexpr int benchRuns = 5;
+
+  struct CirclePoint
+  {
+    shapkov::Point center;
+    double radius;
+    size_t count;
+    size_t& index;
+    shapkov::Point operator()() const
+    {
+      double angle = 2 * 3.14159265358979323846 * index++ / count;
+      return shapkov::Point{ center.x + radius * std::cos(angle), center.y + radius * std::sin(angle) };
+    }
+  };
+  // convex polygons keep Heron's formula away from the NaNs that slivers give
+  struct RandomPolygon
+  {
+    std::mt19937& random;
+    shapkov::Polygon operator()() const
+    {
+      std::uniform_int_distribution< size_t > vertexes(3, 12);
+      std::uniform_real_distribution< double > shift(-1000.0, 1000.0);
+      std::uniform_real_distribution< double > radius(1.0, 100.0);
+      shapkov::Polygon polygon;
+      polygon.points.resize(vertexes(random));
+      size_t index = 0;
+      std::generate(polygon.points.begin(), polygon.points.end(),
+          CirclePoint{ shapkov::Point{ shift(random), shift(random) }, radius(random), polygon.points.size(), index });
+      return polygon;
+    }
+  };
+
+  // the getArea that came before the in-place fan: one Polygon is built
+  // per triangle before the areas are summed
+  struct TriangleArea
+  {
+    double operator()(const shapkov::Polygon& triangle) const
+    {
+      return shapkov::getAreaOfTriangle(triangle.points[0], triangle.points[1], triangle.points[2]);
+    }
+  };
+  struct MakeTriangle
+  {
+    const shapkov::PolygonView& points;
+    size_t& index;
+    shapkov::Polygon operator()() const
+    {
+      size_t i = index++;
+      return shapkov::Polygon{ std::vector< shapkov::Point >{ points[0], points[i + 1], points[i + 2] } };
+    }
+  };
+  double getTriangulatedArea(const shapkov::PolygonView& p)
+  {
+    std::vector< shapkov::Polygon > triangles(p.size() - 2);
+    size_t index = 0;
+    std::generate(triangles.begin(), triangles.end(), MakeTriangle{ p, index });
+    std::vector< double > areas;
+    std::transform(triangles.begin(), triangles.end(), std::back_inserter(areas), TriangleArea{});
+    return std::accumulate(areas.begin(), areas.end(), 0.0);
+  }
+
+  using AreaFunction = double (*)(const shapkov::PolygonView&);
+  struct SumAreas
+  {
+    const shapkov::VecOfPolygons& polygons;
+    AreaFunction area;
+    double& result;
+    void operator()() const
+    {
+      std::vector< double > areas(polygons.size());
+      std::transform(polygons.begin(), polygons.end(), areas.begin(), area);
+      result = std::accumulate(areas.begin(), areas.end(), 0.0);
+    }
+  };
+
+  // the loop of main, once with status codes and once with the exception
+  // that the commands used to throw for every invalid line
+  struct RunScript
+  {
+    const std::string& script;
+    const shapkov::VecOfPolygons& polygons;
+    bool throwing;
+    size_t& invalid;
+    void operator()() const
+    {
+      std::istringstream in(script);
+      std::ostringstream out;
+      std::string command;
+      invalid = 0;
+      while (!(in >> command).eof())
+      {
+        shapkov::CmdStatus status = shapkov::CmdStatus::unknownCommand;
+        try
+        {
+          status = (command == "COUNT") ? shapkov::count(in, out, polygons) : shapkov::area(in, out, polygons);
+          if (throwing && (status != shapkov::CmdStatus::ok))
+          {
+            throw std::logic_error("invalid command");
+          }
+        }
+        catch (const std::logic_error&)
+        {}
+        if (status != shapkov::CmdStatus::ok)
+        {
+          in.clear();
+          in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+          invalid++;
+        }
+      }
+    }
+  };
+
+  double bestOf(const std::function< void() >& run)
+  {
+    double best = std::numeric_limits< double >::max();
+    for (int i = 0; i < benchRuns; i++)
+    {
+      Clock::time_point start = Clock::now();
+      run();
+      best = std::min(best, std::chrono::duration< double, std::milli >(Clock::now() - start).count());
+    }
+    return best;
+  }
+}
+
+int main()
+{
+  std::mt19937 random(2024);
+  std::vector< shapkov::Polygon > source(benchPolygons);
+  std::generate(source.begin(), source.end(), RandomPolygon{ random });
+  shapkov::PolygonArena arena;
+  std::for_each(source.begin(), source.end(), std::bind(&shapkov::PolygonArena::push_back, std::ref(arena), std::placeholders::_1));
+  const shapkov::VecOfPolygons polygons = arena.views();
+
+  double inPlace = 0.0;
+  double triangulated = 0.0;
+  double inPlaceTime = bestOf(SumAreas{ polygons, shapkov::getArea, inPlace });
+  double triangulatedTime = bestOf(SumAreas{ polygons, getTriangulatedArea, triangulated });
+  std::cout << "area of " << benchPolygons << " polygons: in place " << inPlaceTime << " ms, triangulated ";
+  std::cout << triangulatedTime << " ms" << (inPlace == triangulated ? "" : " (sums differ)") << '\n';
+
+  const std::string invalidLines[] = { "AREA FOO\n", "COUNT 2\n", "AREA 1\n", "COUNT X\n" };
+  const size_t invalidKinds = sizeof(invalidLines) / sizeof(invalidLines[0]);
+  std::ostringstream script;
+  for (size_t i = 0; i < benchLines; i++)
+  {
+    script << invalidLines[i % invalidKinds];
+  }
+  const std::string text = script.str();
+  size_t statusInvalid = 0;
+  size_t throwingInvalid = 0;
+  double statusTime = bestOf(RunScript{ text, polygons, false, statusInvalid });
+  double throwingTime = bestOf(RunScript{ text, polygons, true, throwingInvalid });
+  std::cout << benchLines << " invalid lines: status codes " << statusTime << " ms, exceptions ";
+  std::cout << throwingTime << " ms" << (statusInvalid == throwingInvalid ? "" : " (counts differ)") << '\n';
+  return 0;
+}
@@ -0,0 +1,441 @@
+#include "columnar_store.hpp"
+#ifdef TKACH_OUT_OF_CORE
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "geometry.hpp"
+#include "same_index.hpp"
+
+namespace
+{
+  const char magic[4] = {'T', 'K', 'C', 'L'};
+  const uint32_t version = 3;
+  const uint64_t hash_chunk = 1 << 20;
+  const uint64_t points_offset = 4096;
+
+  struct ColumnsHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint64_t polygons;
+    uint64_t points;
+    uint64_t fingerprints;
+    tkach::Box frame;
+    tkach::SourceStamp source;
+  };
+
+  class PositionIterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const size_t*;
+    using reference = const size_t&;
+
+    explicit PositionIterator(size_t pos):
+      pos_(pos)
+    {}
+    reference operator*() const
+    {
+      return pos_;
+    }
+    PositionIterator& operator++()
+    {
+      ++pos_;
+      return *this;
+    }
+    PositionIterator& operator--()
+    {
+      --pos_;
+      return *this;
+    }
+    PositionIterator& operator+=(difference_type diff)
+    {
+      pos_ += diff;
+      return *this;
+    }
+    difference_type operator-(const PositionIterator& rhs) const
+    {
+      return pos_ - rhs.pos_;
+    }
+    bool operator==(const PositionIterator& rhs) const
+    {
+      return pos_ == rhs.pos_;
+    }
+    bool operator!=(const PositionIterator& rhs) const
+    {
+      return pos_ != rhs.pos_;
+    }
+  private:
+    size_t pos_;
+  };
+
+  template< class T >
+  void writeColumn(std::ostream& out, const std::vector< T >& column)
+  {
+    out.write(reinterpret_cast< const char* >(column.data()), column.size() * sizeof(T));
+  }
+
+  template< class T >
+  void readColumn(std::istream& in, std::vector< T >& column, size_t size)
+  {
+    column.resize(size);
+    in.read(reinterpret_cast< char* >(column.data()), size * sizeof(T));
+  }
+
+  template< class T >
+  T loadEntry(tkach::PageCache& pages, uint64_t column, size_t pos)
+  {
+    T entry;
+    std::memcpy(&entry, pages.map(column + pos * sizeof(T), sizeof(T)), sizeof(T));
+    return entry;
+  }
+
+  bool compareFingerprint(const tkach::Fingerprint& lhs, const tkach::Fingerprint& rhs)
+  {
+    return lhs.hash < rhs.hash || (lhs.hash == rhs.hash && lhs.pos < rhs.pos);
+  }
+
+  struct HashBelow
+  {
+    const tkach::ColumnarStore& store;
+    size_t hash;
+    bool operator()(size_t entry) const
+    {
+      return store.fingerprint(entry).hash < hash;
+    }
+  };
+
+  struct HashNotAbove
+  {
+    const tkach::ColumnarStore& store;
+    size_t hash;
+    bool operator()(size_t entry) const
+    {
+      return store.fingerprint(entry).hash <= hash;
+    }
+  };
+
+  struct StoredSame
+  {
+    const tkach::ColumnarStore& store;
+    const tkach::Polygon& target;
+    bool operator()(size_t pos) const
+    {
+      return store.vertexes()[pos] == target.points.size() && tkach::isSame(target, store.at(pos));
+    }
+  };
+
+  struct BucketStoredSame
+  {
+    StoredSame same;
+    bool operator()(size_t entry) const
+    {
+      return same(same.store.fingerprint(entry).pos);
+    }
+  };
+
+  struct HashWord
+  {
+    uint64_t operator()(uint64_t hash, uint64_t word) const
+    {
+      hash = (hash ^ word) * 0x100000001b3ULL;
+      return hash ^ (hash >> 29);
+    }
+  };
+
+  struct HashByte
+  {
+    uint64_t operator()(uint64_t hash, char byte) const
+    {
+      return (hash ^ static_cast< unsigned char >(byte)) * 0x100000001b3ULL;
+    }
+  };
+
+  struct HashChunk
+  {
+    int fd;
+    uint64_t size;
+    uint64_t operator()(uint64_t hash, size_t chunk) const
+    {
+      const uint64_t begin = chunk * hash_chunk;
+      const size_t length = std::min(hash_chunk, size - begin);
+      void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, begin);
+      if (address == MAP_FAILED)
+      {
+        throw std::runtime_error("Error: cannot read the input file");
+      }
+      const uint64_t* words = static_cast< const uint64_t* >(address);
+      const uint64_t* words_end = words + length / sizeof(uint64_t);
+      hash = std::accumulate(words, words_end, hash, HashWord{});
+      const char* tail = reinterpret_cast< const char* >(words_end);
+      hash = std::accumulate(tail, static_cast< const char* >(address) + length, hash, HashByte{});
+      munmap(address, length);
+      return hash;
+    }
+  };
+
+  tkach::SourceStamp statSource(const std::string& path)
+  {
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) != 0)
+    {
+      throw std::runtime_error("Error: cannot open the input file");
+    }
+#ifdef __APPLE__
+    const struct timespec& mtime = file_stat.st_mtimespec;
+#else
+    const struct timespec& mtime = file_stat.st_mtim;
+#endif
+    return {static_cast< uint64_t >(file_stat.st_size), mtime.tv_sec, mtime.tv_nsec, 0};
+  }
+
+  uint64_t hashSource(const std::string& path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0)
+    {
+      if (fd >= 0)
+      {
+        close(fd);
+      }
+      throw std::runtime_error("Error: cannot open the input file");
+    }
+    const uint64_t size = file_stat.st_size;
+    const size_t chunks = (size + hash_chunk - 1) / hash_chunk;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    try
+    {
+      hash = std::accumulate(PositionIterator{0}, PositionIterator{chunks}, hash, HashChunk{fd, size});
+    }
+    catch (...)
+    {
+      close(fd);
+      throw;
+    }
+    close(fd);
+    return hash;
+  }
+
+  // the input is hashed only when its size and mtime already match the stored ones
+  bool isSameSource(const tkach::SourceStamp& stored, const std::string& path)
+  {
+    const tkach::SourceStamp current = statSource(path);
+    return current.size == stored.size && current.mtime_sec == stored.mtime_sec
+      && current.mtime_nsec == stored.mtime_nsec && hashSource(path) == stored.content;
+  }
+
+  void convertToColumns(const std::string& input, const std::string& columns)
+  {
+    tkach::SourceStamp source = statSource(input);
+    source.content = hashSource(input);
+    std::ifstream in(input);
+    if (!in.is_open())
+    {
+      throw std::runtime_error("Error: cannot open the input file");
+    }
+    tkach::ColumnarWriter writer(columns, source);
+    tkach::readPolygons(in, std::ref(writer));
+    writer.finish();
+  }
+}
+
+tkach::ColumnarWriter::ColumnarWriter(const std::string& path, const SourceStamp& source):
+  path_(path),
+  temp_path_(path + "." + std::to_string(getpid()) + ".tmp"),
+  out_(temp_path_, std::ios::binary | std::ios::trunc),
+  source_(source),
+  points_(0),
+  frame_{{0, 0}, {0, 0}},
+  vertexes_(),
+  areas_(),
+  rects_(),
+  fingerprints_()
+{
+  if (!out_.is_open())
+  {
+    throw std::runtime_error("Error: cannot create the columns file");
+  }
+  writeColumn(out_, std::vector< char >(points_offset, 0));
+}
+
+void tkach::ColumnarWriter::operator()(const Polygon& polygon)
+{
+  writeColumn(out_, polygon.points);
+  frame_ = vertexes_.empty() ? getBox(polygon) : uniteBoxes(frame_, getBox(polygon));
+  size_t hash = 0;
+  if (computeFingerprint(polygon, hash))
+  {
+    fingerprints_.push_back({hash, vertexes_.size()});
+  }
+  points_ += polygon.points.size();
+  vertexes_.push_back(polygon.points.size());
+  areas_.push_back(calculatePolygonArea(polygon));
+  rects_.push_back(isRect(polygon));
+}
+
+void tkach::ColumnarWriter::finish()
+{
+  std::vector< uint64_t > offsets(vertexes_.size());
+  if (!vertexes_.empty())
+  {
+    std::partial_sum(vertexes_.cbegin(), vertexes_.cend() - 1, offsets.begin() + 1, std::plus< uint64_t >());
+  }
+  std::sort(fingerprints_.begin(), fingerprints_.end(), compareFingerprint);
+  writeColumn(out_, offsets);
+  writeColumn(out_, fingerprints_);
+  writeColumn(out_, vertexes_);
+  writeColumn(out_, areas_);
+  writeColumn(out_, rects_);
+  ColumnsHeader header{{}, version, vertexes_.size(), points_, fingerprints_.size(), frame_, source_};
+  std::copy_n(magic, sizeof(magic), header.magic);
+  out_.seekp(0);
+  out_.write(reinterpret_cast< const char* >(&header), sizeof(header));
+  out_.close();
+  if (!out_ || std::rename(temp_path_.c_str(), path_.c_str()) != 0)
+  {
+    std::remove(temp_path_.c_str());
+    throw std::runtime_error("Error: cannot write the columns file");
+  }
+}
+
+tkach::ColumnarStore::ColumnarStore(const std::string& path, size_t memory_limit):
+  fd_(open(path.c_str(), O_RDONLY)),
+  source_{0, 0, 0, 0},
+  frame_{{0, 0}, {0, 0}},
+  vertexes_(),
+  areas_(),
+  rects_(),
+  offsets_column_(0),
+  fingerprints_column_(0),
+  fingerprints_(0),
+  pages_()
+{
+  std::ifstream in(path, std::ios::binary);
+  ColumnsHeader header{};
+  struct stat file_stat;
+  if (fd_ < 0 || fstat(fd_, &file_stat) != 0 || !in.read(reinterpret_cast< char* >(&header), sizeof(header)))
+  {
+    if (fd_ >= 0)
+    {
+      close(fd_);
+    }
+    throw std::runtime_error("Error: cannot read the columns file");
+  }
+  const uint64_t file_size = file_stat.st_size;
+  offsets_column_ = points_offset + header.points * sizeof(Point);
+  fingerprints_column_ = offsets_column_ + header.polygons * sizeof(uint64_t);
+  const uint64_t summary_column = fingerprints_column_ + header.fingerprints * sizeof(Fingerprint);
+  const uint64_t expected_size = summary_column + header.polygons * (sizeof(uint32_t) + sizeof(double) + sizeof(char));
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version || file_size != expected_size)
+  {
+    close(fd_);
+    throw std::runtime_error("Error: the columns file is damaged");
+  }
+  source_ = header.source;
+  frame_ = header.frame;
+  fingerprints_ = header.fingerprints;
+  in.seekg(summary_column);
+  readColumn(in, vertexes_, header.polygons);
+  readColumn(in, areas_, header.polygons);
+  readColumn(in, rects_, header.polygons);
+  if (!in)
+  {
+    close(fd_);
+    throw std::runtime_error("Error: cannot read the columns file");
+  }
+  pages_.reset(new PageCache(fd_, file_size, memory_limit));
+}
+
+tkach::ColumnarStore::~ColumnarStore()
+{
+  pages_.reset();
+  close(fd_);
+}
+
+size_t tkach::ColumnarStore::size() const
+{
+  return vertexes_.size();
+}
+
+const std::vector< uint32_t >& tkach::ColumnarStore::vertexes() const
+{
+  return vertexes_;
+}
+
+const std::vector< double >& tkach::ColumnarStore::areas() const
+{
+  return areas_;
+}
+
+const std::vector< char >& tkach::ColumnarStore::rects() const
+{
+  return rects_;
+}
+
+const tkach::SourceStamp& tkach::ColumnarStore::source() const
+{
+  return source_;
+}
+
+const tkach::Box& tkach::ColumnarStore::frame() const
+{
+  return frame_;
+}
+
+tkach::Polygon tkach::ColumnarStore::at(size_t pos) const
+{
+  const uint64_t offset = loadEntry< uint64_t >(*pages_, offsets_column_, pos);
+  const uint64_t length = vertexes_[pos] * sizeof(Point);
+  const Point* points = reinterpret_cast< const Point* >(pages_->map(points_offset + offset * sizeof(Point), length));
+  Polygon polygon;
+  polygon.points.assign(points, points + vertexes_[pos]);
+  return polygon;
+}
+
+tkach::Fingerprint tkach::ColumnarStore::fingerprint(size_t entry) const
+{
+  return loadEntry< Fingerprint >(*pages_, fingerprints_column_, entry);
+}
+
+size_t tkach::ColumnarStore::countSame(const Polygon& target) const
+{
+  StoredSame same{*this, target};
+  size_t hash = 0;
+  if (!computeFingerprint(target, hash))
+  {
+    return std::count_if(PositionIterator{0}, PositionIterator{size()}, same);
+  }
+  PositionIterator first = std::partition_point(PositionIterator{0}, PositionIterator{fingerprints_},
+    HashBelow{*this, hash});
+  PositionIterator last = std::partition_point(first, PositionIterator{fingerprints_}, HashNotAbove{*this, hash});
+  return std::count_if(first, last, BucketStoredSame{same});
+}
+
+std::unique_ptr< tkach::ColumnarStore > tkach::openColumnarStore(const std::string& input, size_t memory_limit)
+{
+  const std::string columns = input + ".columns";
+  try
+  {
+    std::unique_ptr< ColumnarStore > store(new ColumnarStore(columns, memory_limit));
+    if (isSameSource(store->source(), input))
+    {
+      return store;
+    }
+  }
+  catch (const std::runtime_error&)
+  {}
+  convertToColumns(input, columns);
+  return std::unique_ptr< ColumnarStore >(new ColumnarStore(columns, memory_limit));
+}
+#endif
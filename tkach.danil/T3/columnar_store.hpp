@@ -0,0 +1,80 @@
+#ifndef COLUMNAR_STORE_HPP
+#define COLUMNAR_STORE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "shapes.hpp"
+#include "frame.hpp"
+#include "page_cache.hpp"
+
+namespace tkach
+{
+  struct Fingerprint
+  {
+    size_t hash;
+    size_t pos;
+  };
+
+  struct SourceStamp
+  {
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint64_t content;
+  };
+
+  class ColumnarWriter
+  {
+  public:
+    ColumnarWriter(const std::string& path, const SourceStamp& source);
+    void operator()(const Polygon& polygon);
+    void finish();
+  private:
+    std::string path_;
+    std::string temp_path_;
+    std::ofstream out_;
+    SourceStamp source_;
+    uint64_t points_;
+    Box frame_;
+    std::vector< uint32_t > vertexes_;
+    std::vector< double > areas_;
+    std::vector< char > rects_;
+    std::vector< Fingerprint > fingerprints_;
+  };
+
+  class ColumnarStore
+  {
+  public:
+    ColumnarStore(const std::string& path, size_t memory_limit);
+    ColumnarStore(const ColumnarStore&) = delete;
+    ColumnarStore& operator=(const ColumnarStore&) = delete;
+    ~ColumnarStore();
+    size_t size() const;
+    const std::vector< uint32_t >& vertexes() const;
+    const std::vector< double >& areas() const;
+    const std::vector< char >& rects() const;
+    const SourceStamp& source() const;
+    const Box& frame() const;
+    Polygon at(size_t pos) const;
+    Fingerprint fingerprint(size_t entry) const;
+    size_t countSame(const Polygon& target) const;
+  private:
+    int fd_;
+    SourceStamp source_;
+    Box frame_;
+    std::vector< uint32_t > vertexes_;
+    std::vector< double > areas_;
+    std::vector< char > rects_;
+    uint64_t offsets_column_;
+    uint64_t fingerprints_column_;
+    size_t fingerprints_;
+    std::unique_ptr< PageCache > pages_;
+  };
+
+  std::unique_ptr< ColumnarStore > openColumnarStore(const std::string& input, size_t memory_limit);
+}
+
+#endif
@@ -4,86 +4,12 @@
 #include <algorithm>
 #include <numeric>
 #include <iterator>
-#include <cmath>
 #include <iomanip>
 #include <streamguard.hpp>
+#include "geometry.hpp"
 
 namespace
 {
-  struct PolyAreaAccumulator
-  {
-    double operator()(const tkach::Point& p1, const tkach::Point& p2) const
-    {
-      return static_cast< double >(p1.x) * p2.y - static_cast< double >(p1.y) * p2.x;
-    }
-  };
-
-  bool pointCmp(const tkach::Point& lhs, const tkach::Point& rhs)
-  {
-    if (lhs.x != rhs.x)
-    {
-      return lhs.x < rhs.x;
-    }
-    else
-    {
-      return lhs.y < rhs.y;
-    }
-  }
-
-  bool pointEqual(const tkach::Point& lhs, const tkach::Point& rhs)
-  {
-    return (lhs.x == rhs.x) && (lhs.y == rhs.y);
-  }
-
-  tkach::Point findMinXYPoint(const tkach::Polygon& polygon)
-  {
-    return *std::min_element(polygon.points.cbegin(), polygon.points.cend(), pointCmp);
-  }
-
-  bool hasPoint(const tkach::Point& delta, const tkach::Point& point, const tkach::Polygon& polygon)
-  {
-    tkach::Point res = {point.x + delta.x, point.y + delta.y};
-    using namespace std::placeholders;
-    auto accum_same = std::bind(pointEqual, res, _1);
-    return std::find_if(polygon.points.cbegin(), polygon.points.cend(), accum_same) != polygon.points.cend();
-  }
-
-  struct PolySame
-  {
-    const tkach::Polygon& poly;
-    bool operator()(const tkach::Polygon& polygon)
-    {
-      if (poly.points.size() != polygon.points.size())
-      {
-        return false;
-      }
-      if (polygon.points.empty())
-      {
-        return true;
-      }
-      tkach::Point target_min = findMinXYPoint(poly);
-      tkach::Point poly_min = findMinXYPoint(polygon);
-      tkach::Point delta = {poly_min.x - target_min.x, poly_min.y - target_min.y};
-      auto predicate = std::bind(hasPoint, delta, std::placeholders::_1, std::cref(polygon));
-      size_t count_matched_points = std::count_if(poly.points.cbegin(), poly.points.cend(), predicate);
-      return count_matched_points == poly.points.size();
-    }
-  };
-
-  double calculatePolygonArea(const tkach::Polygon& polygon)
-  {
-    if (polygon.points.size() < 3)
-    {
-      return 0.0;
-    }
-    PolyAreaAccumulator accum{};
-    auto begin_it = polygon.points.begin();
-    auto end_it = polygon.points.end();
-    double sum = std::inner_product(begin_it, end_it - 1, begin_it + 1, 0.0, std::plus< double >(), accum);
-    sum += accum(polygon.points[polygon.points.size() - 1], polygon.points[0]);
-    return std::fabs(sum) / 2.0;
-  }
-
   bool isEven(const tkach::Polygon& polygon)
   {
     return polygon.points.size() % 2 == 0;
@@ -102,7 +28,7 @@ namespace
   double sumPolyVector(const std::vector< tkach::Polygon >& poly)
   {
     std::vector< double > areas;
-    std::transform(poly.begin(), poly.end(), std::back_inserter(areas), calculatePolygonArea);
+    std::transform(poly.begin(), poly.end(), std::back_inserter(areas), tkach::calculatePolygonArea);
     return std::accumulate(areas.begin(), areas.end(), 0.0);
   }
 
@@ -159,7 +85,7 @@ namespace
 
   bool compareArea(const tkach::Polygon& lhs, const tkach::Polygon& rhs)
   {
-    return calculatePolygonArea(lhs) < calculatePolygonArea(rhs);
+    return tkach::calculatePolygonArea(lhs) < tkach::calculatePolygonArea(rhs);
   }
 
   bool compareVertex(const tkach::Polygon& lhs, const tkach::Polygon& rhs)
@@ -169,7 +95,7 @@ namespace
 
   std::ostream& printMaxArea(std::ostream& out, const std::vector< tkach::Polygon >& data)
   {
-    double result = calculatePolygonArea(*(std::max_element(data.cbegin(), data.cend(), compareArea)));
+    double result = tkach::calculatePolygonArea(*(std::max_element(data.cbegin(), data.cend(), compareArea)));
     tkach::StreamGuard guard(out);
     out << std::fixed << std::setprecision(1) << result << "\n";
     return out;
@@ -185,7 +111,7 @@ namespace
 
   std::ostream& printMinArea(std::ostream& out, const std::vector< tkach::Polygon >& data)
   {
-    double result = calculatePolygonArea(*(std::min_element(data.cbegin(), data.cend(), compareArea)));
+    double result = tkach::calculatePolygonArea(*(std::min_element(data.cbegin(), data.cend(), compareArea)));
     tkach::StreamGuard guard(out);
     out << std::fixed << std::setprecision(1) << result << "\n";
     return out;
@@ -198,20 +124,6 @@ namespace
     out << result << "\n";
     return out;
   }
-
-  double getDistance(const tkach::Point& lhs, const tkach::Point& rhs)
-  {
-    return std::sqrt(std::pow((lhs.x - rhs.x), 2) + std::pow((lhs.y - rhs.y), 2));
-  }
-
-  bool isRect(const tkach::Polygon& polygon)
-  {
-    if (polygon.points.size() != 4)
-    {
-      return false;
-    }
-    return (getDistance(polygon.points[0], polygon.points[2]) - getDistance(polygon.points[1], polygon.points[3])) < 1e-9;
-  }
 }
 
 void tkach::printMax(std::istream& in, std::ostream& out, const std::vector< Polygon >& data)
@@ -260,20 +172,29 @@ void tkach::printMin(std::istream& in, std::ostream& out, const std::vector< Pol
   }
 }
 
-void tkach::printSame(std::istream& in, std::ostream& out, const std::vector< Polygon >& data)
+void tkach::printSame(std::istream& in, std::ostream& out, const SameIndex& index)
 {
   Polygon target;
   if (!(in >> target) || target.points.size() < 3 || in.peek() != '\n')
   {
     throw std::logic_error("Error: not polygon");
   }
-  PolySame cmp{target};
-  out << std::count_if(data.begin(), data.end(), cmp) << '\n';
+  out << index.count(target) << '\n';
+}
+
+void tkach::printInFrame(std::istream& in, std::ostream& out, const Frame& frame)
+{
+  Polygon target;
+  if (!(in >> target) || target.points.size() < 3 || in.peek() != '\n' || frame.empty())
+  {
+    throw std::logic_error("Error: not polygon");
+  }
+  out << (frame.contains(target) ? "<TRUE>" : "<FALSE>") << '\n';
 }
 
 void tkach::printRects(std::ostream& out, const std::vector< Polygon >& data)
 {
-  out << std::count_if(data.begin(), data.end(), isRect) << "\n";
+  out << std::count_if(data.begin(), data.end(), tkach::isRect) << "\n";
 }
 
 void tkach::printCount(std::istream& in, std::ostream& out, const std::vector< Polygon >& data)
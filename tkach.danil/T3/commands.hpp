@@ -4,6 +4,8 @@
 #include <vector>
 #include <iostream>
 #include "shapes.hpp"
+#include "same_index.hpp"
+#include "frame.hpp"
 
 namespace tkach
 {
@@ -11,8 +13,9 @@ namespace tkach
   void printMax(std::istream& in, std::ostream& out, const std::vector< Polygon >& data);
   void printMin(std::istream& in, std::ostream& out, const std::vector< Polygon >& data);
   void printCount(std::istream& in, std::ostream& out, const std::vector< Polygon >& data);
-  void printSame(std::istream& in, std::ostream& out, const std::vector< Polygon >& data);
+  void printSame(std::istream& in, std::ostream& out, const SameIndex& index);
   void printRects(std::ostream& out, const std::vector< Polygon >& data);
+  void printInFrame(std::istream& in, std::ostream& out, const Frame& frame);
 }
 
 #endif
@@ -0,0 +1,97 @@
+#include "frame.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+  tkach::Box extendBox(const tkach::Box& box, const tkach::Point& point)
+  {
+    tkach::Point min = {std::min(box.min.x, point.x), std::min(box.min.y, point.y)};
+    tkach::Point max = {std::max(box.max.x, point.x), std::max(box.max.y, point.y)};
+    return {min, max};
+  }
+
+  tkach::Box uniteWithPolygon(const tkach::Box& box, const tkach::Polygon& polygon)
+  {
+    return tkach::uniteBoxes(box, tkach::getBox(polygon));
+  }
+
+  bool touchesBorder(const tkach::Box& box, const tkach::Box& frame)
+  {
+    return box.min.x == frame.min.x || box.min.y == frame.min.y || box.max.x == frame.max.x || box.max.y == frame.max.y;
+  }
+}
+
+tkach::Box tkach::getBox(const Polygon& polygon)
+{
+  const Point& first = polygon.points.front();
+  return std::accumulate(polygon.points.cbegin(), polygon.points.cend(), Box{first, first}, extendBox);
+}
+
+tkach::Box tkach::uniteBoxes(const Box& lhs, const Box& rhs)
+{
+  return extendBox(extendBox(lhs, rhs.min), rhs.max);
+}
+
+bool tkach::coversBox(const Box& outer, const Box& inner)
+{
+  return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+tkach::Frame::Frame(const std::vector< Polygon >& data):
+  data_(data),
+  box_{{0, 0}, {0, 0}},
+  empty_(true),
+  dirty_(false)
+{
+  recompute();
+}
+
+void tkach::Frame::insert(const Polygon& polygon)
+{
+  if (dirty_)
+  {
+    return;
+  }
+  const Box box = getBox(polygon);
+  box_ = empty_ ? box : uniteBoxes(box_, box);
+  empty_ = false;
+}
+
+void tkach::Frame::erase(const Polygon& polygon)
+{
+  if (!dirty_ && !empty_ && touchesBorder(getBox(polygon), box_))
+  {
+    dirty_ = true;
+  }
+}
+
+bool tkach::Frame::empty() const
+{
+  if (dirty_)
+  {
+    recompute();
+  }
+  return empty_;
+}
+
+bool tkach::Frame::contains(const Polygon& polygon) const
+{
+  if (empty())
+  {
+    return false;
+  }
+  return coversBox(box_, getBox(polygon));
+}
+
+void tkach::Frame::recompute() const
+{
+  dirty_ = false;
+  empty_ = data_.empty();
+  if (empty_)
+  {
+    return;
+  }
+  const Box first = getBox(data_.front());
+  box_ = std::accumulate(data_.cbegin() + 1, data_.cend(), first, uniteWithPolygon);
+}
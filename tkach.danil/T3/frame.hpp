@@ -0,0 +1,34 @@
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include <vector>
+#include "shapes.hpp"
+
+namespace tkach
+{
+  struct Box
+  {
+    Point min;
+    Point max;
+  };
+  Box getBox(const Polygon& polygon);
+  Box uniteBoxes(const Box& lhs, const Box& rhs);
+  bool coversBox(const Box& outer, const Box& inner);
+  class Frame
+  {
+  public:
+    explicit Frame(const std::vector< Polygon >& data);
+    void insert(const Polygon& polygon);
+    void erase(const Polygon& polygon);
+    bool empty() const;
+    bool contains(const Polygon& polygon) const;
+  private:
+    const std::vector< Polygon >& data_;
+    mutable Box box_;
+    mutable bool empty_;
+    mutable bool dirty_;
+    void recompute() const;
+  };
+}
+
+#endif
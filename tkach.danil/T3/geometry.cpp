@@ -0,0 +1,43 @@
+#include "geometry.hpp"
+#include <functional>
+#include <numeric>
+#include <cmath>
+
+namespace
+{
+  struct PolyAreaAccumulator
+  {
+    double operator()(const tkach::Point& p1, const tkach::Point& p2) const
+    {
+      return static_cast< double >(p1.x) * p2.y - static_cast< double >(p1.y) * p2.x;
+    }
+  };
+
+  double getDistance(const tkach::Point& lhs, const tkach::Point& rhs)
+  {
+    return std::sqrt(std::pow((lhs.x - rhs.x), 2) + std::pow((lhs.y - rhs.y), 2));
+  }
+}
+
+double tkach::calculatePolygonArea(const Polygon& polygon)
+{
+  if (polygon.points.size() < 3)
+  {
+    return 0.0;
+  }
+  PolyAreaAccumulator accum{};
+  auto begin_it = polygon.points.begin();
+  auto end_it = polygon.points.end();
+  double sum = std::inner_product(begin_it, end_it - 1, begin_it + 1, 0.0, std::plus< double >(), accum);
+  sum += accum(polygon.points[polygon.points.size() - 1], polygon.points[0]);
+  return std::fabs(sum) / 2.0;
+}
+
+bool tkach::isRect(const Polygon& polygon)
+{
+  if (polygon.points.size() != 4)
+  {
+    return false;
+  }
+  return (getDistance(polygon.points[0], polygon.points[2]) - getDistance(polygon.points[1], polygon.points[3])) < 1e-9;
+}
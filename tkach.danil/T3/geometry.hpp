@@ -0,0 +1,12 @@
+#ifndef GEOMETRY_HPP
+#define GEOMETRY_HPP
+
+#include "shapes.hpp"
+
+namespace tkach
+{
+  double calculatePolygonArea(const Polygon& polygon);
+  bool isRect(const Polygon& polygon);
+}
+
+#endif
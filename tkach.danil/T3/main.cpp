@@ -6,13 +6,94 @@
 #include <functional>
 #include <string>
 #include <map>
+#include <memory>
+#include <cstdlib>
 #include "shapes.hpp"
 #include "commands.hpp"
+#include "stored_commands.hpp"
+
+namespace
+{
+  using commands_map = std::map< std::string, std::function< void() > >;
+
+  void processCommands(const commands_map& cmds)
+  {
+    std::string command;
+    while (!(std::cin >> command).eof()) {
+      try
+      {
+        cmds.at(command)();
+      }
+      catch (...)
+      {
+        if (std::cin.fail())
+        {
+          std::cin.clear(std::cin.rdstate() ^ std::ios::failbit);
+        }
+        std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+        std::cout << "<INVALID COMMAND>\n";
+      }
+    }
+  }
+
+  struct AppendPolygon
+  {
+    std::vector< tkach::Polygon >& data;
+    void operator()(const tkach::Polygon& polygon)
+    {
+      data.push_back(polygon);
+    }
+  };
+
+  int runInMemory(std::istream& in)
+  {
+    using namespace tkach;
+    std::vector< Polygon > data;
+    readPolygons(in, AppendPolygon{data});
+    SameIndex same_index(data);
+    Frame frame(data);
+    commands_map cmds;
+    cmds["AREA"] = std::bind(printArea, std::ref(std::cin), std::ref(std::cout), std::cref(data));
+    cmds["MAX"] = std::bind(printMax, std::ref(std::cin), std::ref(std::cout), std::cref(data));
+    cmds["MIN"] = std::bind(printMin, std::ref(std::cin), std::ref(std::cout), std::cref(data));
+    cmds["COUNT"] = std::bind(printCount, std::ref(std::cin), std::ref(std::cout), std::cref(data));
+    cmds["SAME"] = std::bind(printSame, std::ref(std::cin), std::ref(std::cout), std::cref(same_index));
+    cmds["RECTS"] = std::bind(printRects, std::ref(std::cout), std::cref(data));
+    cmds["INFRAME"] = std::bind(printInFrame, std::ref(std::cin), std::ref(std::cout), std::cref(frame));
+    processCommands(cmds);
+    return 0;
+  }
+
+#ifdef TKACH_OUT_OF_CORE
+  int runOutOfCore(const std::string& input, size_t memory_limit)
+  {
+    using namespace tkach;
+    std::unique_ptr< ColumnarStore > store;
+    try
+    {
+      store = openColumnarStore(input, memory_limit);
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << e.what() << "\n";
+      return 1;
+    }
+    commands_map cmds;
+    cmds["AREA"] = std::bind(printStoredArea, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    cmds["MAX"] = std::bind(printStoredMax, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    cmds["MIN"] = std::bind(printStoredMin, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    cmds["COUNT"] = std::bind(printStoredCount, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    cmds["SAME"] = std::bind(printStoredSame, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    cmds["RECTS"] = std::bind(printStoredRects, std::ref(std::cout), std::cref(*store));
+    cmds["INFRAME"] = std::bind(printStoredInFrame, std::ref(std::cin), std::ref(std::cout), std::cref(*store));
+    processCommands(cmds);
+    return 0;
+  }
+#endif
+}
 
 int main(const int argc, const char* const* const argv)
 {
-  using namespace tkach;
-  using istreamIT = std::istream_iterator< Polygon >;
   if (argc != 2)
   {
     std::cerr << "Error: incorrect input\n";
@@ -24,38 +105,25 @@ int main(const int argc, const char* const* const argv)
     std::cerr << "File is not open\n";
     return 1;
   }
-  std::vector< Polygon > data;
-  while (!in.eof())
+#ifdef TKACH_OUT_OF_CORE
+  const char* memory_limit = std::getenv("TKACH_MEMORY_LIMIT");
+  if (memory_limit != nullptr)
   {
-    std::copy(istreamIT{in}, istreamIT{}, std::back_inserter(data));
-    if (in.fail())
-    {
-      in.clear(in.rdstate() ^ std::ios::failbit);
-      in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
-    }
-  }
-  std::map< std::string, std::function< void() > > cmds;
-  cmds["AREA"] = std::bind(printArea, std::ref(std::cin), std::ref(std::cout), std::cref(data));
-  cmds["MAX"] = std::bind(printMax, std::ref(std::cin), std::ref(std::cout), std::cref(data));
-  cmds["MIN"] = std::bind(printMin, std::ref(std::cin), std::ref(std::cout), std::cref(data));
-  cmds["COUNT"] = std::bind(printCount, std::ref(std::cin), std::ref(std::cout), std::cref(data));
-  cmds["SAME"] = std::bind(printSame, std::ref(std::cin), std::ref(std::cout), std::cref(data));
-  cmds["RECTS"] = std::bind(printRects, std::ref(std::cout), std::cref(data));
-  std::string command;
-  while (!(std::cin >> command).eof()) {
+    size_t limit_mb = 0;
     try
     {
-      cmds.at(command)();
+      limit_mb = std::stoull(memory_limit);
     }
-    catch (...)
+    catch (const std::exception&)
+    {}
+    if (limit_mb == 0)
     {
-      if (std::cin.fail())
-      {
-        std::cin.clear(std::cin.rdstate() ^ std::ios::failbit);
-      }
-      std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
-      std::cout << "<INVALID COMMAND>\n";
+      std::cerr << "Error: incorrect memory limit\n";
+      return 1;
     }
+    in.close();
+    return runOutOfCore(argv[1], limit_mb << 20);
   }
-  return 0;
+#endif
+  return runInMemory(in);
 }
@@ -0,0 +1,88 @@
+#include "page_cache.hpp"
+#ifdef TKACH_OUT_OF_CORE
+#include <algorithm>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+  const uint64_t max_window_size = 1 << 20;
+
+  struct CoversRange
+  {
+    uint64_t begin;
+    uint64_t end;
+    template< class Window >
+    bool operator()(const Window& window) const
+    {
+      return window.begin <= begin && end <= window.begin + window.length;
+    }
+  };
+
+  struct Unmap
+  {
+    template< class Window >
+    void operator()(const Window& window) const
+    {
+      munmap(window.address, window.length);
+    }
+  };
+}
+
+tkach::PageCache::PageCache(int fd, uint64_t file_size, size_t limit):
+  fd_(fd),
+  file_size_(file_size),
+  limit_(limit),
+  page_size_(sysconf(_SC_PAGESIZE)),
+  window_size_(std::max(page_size_, std::min< uint64_t >(max_window_size, limit / 8) / page_size_ * page_size_)),
+  mapped_(0),
+  windows_()
+{}
+
+tkach::PageCache::~PageCache()
+{
+  std::for_each(windows_.cbegin(), windows_.cend(), Unmap{});
+}
+
+const char* tkach::PageCache::map(uint64_t begin, uint64_t length)
+{
+  const uint64_t end = begin + length;
+  if (end > file_size_)
+  {
+    throw std::out_of_range("Error: the range is out of the columns file");
+  }
+  auto window = std::find_if(windows_.begin(), windows_.end(), CoversRange{begin, end});
+  if (window != windows_.end())
+  {
+    windows_.splice(windows_.begin(), windows_, window);
+  }
+  else
+  {
+    const uint64_t window_begin = begin / window_size_ * window_size_;
+    const uint64_t page_end = (end + page_size_ - 1) / page_size_ * page_size_;
+    const uint64_t window_end = std::min(file_size_, std::max(window_begin + window_size_, page_end));
+    const uint64_t window_length = window_end - window_begin;
+    while (!windows_.empty() && mapped_ + window_length > limit_)
+    {
+      evictLast();
+    }
+    void* address = mmap(nullptr, window_length, PROT_READ, MAP_PRIVATE, fd_, window_begin);
+    if (address == MAP_FAILED)
+    {
+      throw std::runtime_error("Error: cannot map the columns file");
+    }
+    windows_.push_front({window_begin, window_length, static_cast< char* >(address)});
+    mapped_ += window_length;
+  }
+  const Window& front = windows_.front();
+  return front.address + (begin - front.begin);
+}
+
+void tkach::PageCache::evictLast()
+{
+  Unmap{}(windows_.back());
+  mapped_ -= windows_.back().length;
+  windows_.pop_back();
+}
+#endif
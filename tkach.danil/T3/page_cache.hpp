@@ -0,0 +1,41 @@
+#ifndef PAGE_CACHE_HPP
+#define PAGE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+
+// the out-of-core mode maps the columns file, so it is only built where mmap exists
+#if defined(__unix__) || defined(__APPLE__)
+#define TKACH_OUT_OF_CORE
+#endif
+
+namespace tkach
+{
+  class PageCache
+  {
+  public:
+    PageCache(int fd, uint64_t file_size, size_t limit);
+    PageCache(const PageCache&) = delete;
+    PageCache& operator=(const PageCache&) = delete;
+    ~PageCache();
+    const char* map(uint64_t begin, uint64_t length);
+  private:
+    struct Window
+    {
+      uint64_t begin;
+      uint64_t length;
+      char* address;
+    };
+    int fd_;
+    uint64_t file_size_;
+    size_t limit_;
+    uint64_t page_size_;
+    uint64_t window_size_;
+    size_t mapped_;
+    std::list< Window > windows_;
+    void evictLast();
+  };
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "same_index.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+namespace
+{
+  bool pointCmp(const tkach::Point& lhs, const tkach::Point& rhs)
+  {
+    if (lhs.x != rhs.x)
+    {
+      return lhs.x < rhs.x;
+    }
+    else
+    {
+      return lhs.y < rhs.y;
+    }
+  }
+
+  bool pointEqual(const tkach::Point& lhs, const tkach::Point& rhs)
+  {
+    return (lhs.x == rhs.x) && (lhs.y == rhs.y);
+  }
+
+  tkach::Point findMinXYPoint(const tkach::Polygon& polygon)
+  {
+    return *std::min_element(polygon.points.cbegin(), polygon.points.cend(), pointCmp);
+  }
+
+  bool hasPoint(const tkach::Point& delta, const tkach::Point& point, const tkach::Polygon& polygon)
+  {
+    tkach::Point res = {point.x + delta.x, point.y + delta.y};
+    using namespace std::placeholders;
+    auto accum_same = std::bind(pointEqual, res, _1);
+    return std::find_if(polygon.points.cbegin(), polygon.points.cend(), accum_same) != polygon.points.cend();
+  }
+
+  struct PolySame
+  {
+    const tkach::Polygon& poly;
+    bool operator()(const tkach::Polygon& polygon) const
+    {
+      if (poly.points.size() != polygon.points.size())
+      {
+        return false;
+      }
+      if (polygon.points.empty())
+      {
+        return true;
+      }
+      tkach::Point target_min = findMinXYPoint(poly);
+      tkach::Point poly_min = findMinXYPoint(polygon);
+      tkach::Point delta = {poly_min.x - target_min.x, poly_min.y - target_min.y};
+      auto predicate = std::bind(hasPoint, delta, std::placeholders::_1, std::cref(polygon));
+      size_t count_matched_points = std::count_if(poly.points.cbegin(), poly.points.cend(), predicate);
+      return count_matched_points == poly.points.size();
+    }
+  };
+
+  struct BucketSame
+  {
+    const std::vector< tkach::Polygon >& data;
+    PolySame same;
+    bool operator()(const std::pair< const size_t, size_t >& entry) const
+    {
+      return same(data[entry.second]);
+    }
+  };
+
+  tkach::Point shiftPoint(const tkach::Point& point, const tkach::Point& origin)
+  {
+    return {point.x - origin.x, point.y - origin.y};
+  }
+
+  size_t combineHash(size_t seed, const tkach::Point& point)
+  {
+    std::hash< int > hash;
+    seed ^= hash(point.x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hash(point.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+}
+
+bool tkach::computeFingerprint(const Polygon& polygon, size_t& fingerprint)
+{
+  if (polygon.points.empty())
+  {
+    return false;
+  }
+  std::vector< Point > normalized;
+  normalized.reserve(polygon.points.size());
+  auto to_origin = std::bind(shiftPoint, std::placeholders::_1, findMinXYPoint(polygon));
+  std::transform(polygon.points.cbegin(), polygon.points.cend(), std::back_inserter(normalized), to_origin);
+  std::sort(normalized.begin(), normalized.end(), pointCmp);
+  if (std::adjacent_find(normalized.cbegin(), normalized.cend(), pointEqual) != normalized.cend())
+  {
+    return false;
+  }
+  fingerprint = std::accumulate(normalized.cbegin(), normalized.cend(), normalized.size(), combineHash);
+  return true;
+}
+
+bool tkach::isSame(const Polygon& lhs, const Polygon& rhs)
+{
+  return PolySame{lhs}(rhs);
+}
+
+tkach::SameIndex::SameIndex(const std::vector< Polygon >& data):
+  data_(data),
+  buckets_()
+{
+  std::vector< size_t > positions(data.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  buckets_.reserve(data.size());
+  std::for_each(positions.cbegin(), positions.cend(), std::bind(&SameIndex::add, this, std::placeholders::_1));
+}
+
+size_t tkach::SameIndex::count(const Polygon& target) const
+{
+  PolySame cmp{target};
+  size_t fingerprint = 0;
+  if (!computeFingerprint(target, fingerprint))
+  {
+    return std::count_if(data_.cbegin(), data_.cend(), cmp);
+  }
+  auto bucket = buckets_.equal_range(fingerprint);
+  return std::count_if(bucket.first, bucket.second, BucketSame{data_, cmp});
+}
+
+void tkach::SameIndex::add(size_t pos)
+{
+  size_t fingerprint = 0;
+  if (computeFingerprint(data_[pos], fingerprint))
+  {
+    buckets_.emplace(fingerprint, pos);
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef SAME_INDEX_HPP
+#define SAME_INDEX_HPP
+
+#include <vector>
+#include <unordered_map>
+#include "shapes.hpp"
+
+namespace tkach
+{
+  bool computeFingerprint(const Polygon& polygon, size_t& fingerprint);
+  bool isSame(const Polygon& lhs, const Polygon& rhs);
+  class SameIndex
+  {
+  public:
+    explicit SameIndex(const std::vector< Polygon >& data);
+    size_t count(const Polygon& target) const;
+  private:
+    const std::vector< Polygon >& data_;
+    std::unordered_multimap< size_t, size_t > buckets_;
+    void add(size_t pos);
+  };
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <common_io_actions.hpp>
 
 namespace tkach
@@ -19,6 +22,21 @@ namespace tkach
   std::istream& operator>>(std::istream& in, Polygon& dest);
   std::ostream& operator<<(std::ostream& out, const Point& dest);
   std::ostream& operator<<(std::ostream& out, const Polygon& dest);
+
+  template< class Function >
+  void readPolygons(std::istream& in, Function function)
+  {
+    using istreamIT = std::istream_iterator< Polygon >;
+    while (!in.eof())
+    {
+      std::for_each(istreamIT{in}, istreamIT{}, function);
+      if (in.fail())
+      {
+        in.clear(in.rdstate() ^ std::ios::failbit);
+        in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+      }
+    }
+  }
 }
 
 #endif
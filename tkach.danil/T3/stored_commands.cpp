@@ -0,0 +1,204 @@
+#include "stored_commands.hpp"
+#ifdef TKACH_OUT_OF_CORE
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+#include <streamguard.hpp>
+
+namespace
+{
+  using CountPredicate = std::function< bool(size_t) >;
+
+  bool isEvenCount(size_t count)
+  {
+    return count % 2 == 0;
+  }
+
+  bool isOddCount(size_t count)
+  {
+    return count % 2 != 0;
+  }
+
+  bool isAnyCount(size_t)
+  {
+    return true;
+  }
+
+  bool isEqualCount(size_t count, size_t required_count)
+  {
+    return count == required_count;
+  }
+
+  CountPredicate makeEqualCount(const std::string& sub_cmd)
+  {
+    size_t count = std::stoull(sub_cmd);
+    if (count < 3)
+    {
+      throw std::logic_error("Error: not polygon");
+    }
+    return std::bind(isEqualCount, std::placeholders::_1, count);
+  }
+
+  struct SelectArea
+  {
+    CountPredicate predicate;
+    double operator()(double area, uint32_t vertexes) const
+    {
+      return predicate(vertexes) ? area : 0.0;
+    }
+  };
+
+  double sumAreas(const tkach::ColumnarStore& store, CountPredicate predicate)
+  {
+    const std::vector< double >& areas = store.areas();
+    const std::vector< uint32_t >& vertexes = store.vertexes();
+    return std::inner_product(areas.cbegin(), areas.cend(), vertexes.cbegin(), 0.0, std::plus< double >(),
+      SelectArea{predicate});
+  }
+
+  double meanArea(const tkach::ColumnarStore& store)
+  {
+    if (store.size() == 0)
+    {
+      throw std::logic_error("Error: zero polygons");
+    }
+    return sumAreas(store, isAnyCount) / store.size();
+  }
+
+  size_t countVertexes(const tkach::ColumnarStore& store, CountPredicate predicate)
+  {
+    return std::count_if(store.vertexes().cbegin(), store.vertexes().cend(), predicate);
+  }
+
+  std::ostream& printArea(std::ostream& out, double area)
+  {
+    tkach::StreamGuard guard(out);
+    out << std::fixed << std::setprecision(1) << area << "\n";
+    return out;
+  }
+
+  std::ostream& printVert(std::ostream& out, uint32_t vertexes)
+  {
+    tkach::StreamGuard guard(out);
+    out << vertexes << "\n";
+    return out;
+  }
+
+  std::ostream& printMaxArea(std::ostream& out, const tkach::ColumnarStore& store)
+  {
+    return printArea(out, *std::max_element(store.areas().cbegin(), store.areas().cend()));
+  }
+
+  std::ostream& printMaxVert(std::ostream& out, const tkach::ColumnarStore& store)
+  {
+    return printVert(out, *std::max_element(store.vertexes().cbegin(), store.vertexes().cend()));
+  }
+
+  std::ostream& printMinArea(std::ostream& out, const tkach::ColumnarStore& store)
+  {
+    return printArea(out, *std::min_element(store.areas().cbegin(), store.areas().cend()));
+  }
+
+  std::ostream& printMinVert(std::ostream& out, const tkach::ColumnarStore& store)
+  {
+    return printVert(out, *std::min_element(store.vertexes().cbegin(), store.vertexes().cend()));
+  }
+
+  using sub_commands_map = std::map< std::string, std::function< std::ostream&() > >;
+
+  void runExtremum(std::istream& in, const tkach::ColumnarStore& store, const sub_commands_map& sub_cmds)
+  {
+    if (store.size() == 0)
+    {
+      throw std::logic_error("Error: zero polygons");
+    }
+    std::string sub_cmd;
+    in >> sub_cmd;
+    try
+    {
+      sub_cmds.at(sub_cmd)();
+    }
+    catch (...)
+    {
+      throw std::logic_error("Error: not that command");
+    }
+  }
+
+  tkach::Polygon readTarget(std::istream& in)
+  {
+    tkach::Polygon target;
+    if (!(in >> target) || target.points.size() < 3 || in.peek() != '\n')
+    {
+      throw std::logic_error("Error: not polygon");
+    }
+    return target;
+  }
+}
+
+void tkach::printStoredMax(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  sub_commands_map sub_cmds;
+  sub_cmds["AREA"] = std::bind(printMaxArea, std::ref(out), std::cref(store));
+  sub_cmds["VERTEXES"] = std::bind(printMaxVert, std::ref(out), std::cref(store));
+  runExtremum(in, store, sub_cmds);
+}
+
+void tkach::printStoredMin(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  sub_commands_map sub_cmds;
+  sub_cmds["AREA"] = std::bind(printMinArea, std::ref(out), std::cref(store));
+  sub_cmds["VERTEXES"] = std::bind(printMinVert, std::ref(out), std::cref(store));
+  runExtremum(in, store, sub_cmds);
+}
+
+void tkach::printStoredSame(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  Polygon target = readTarget(in);
+  out << store.countSame(target) << '\n';
+}
+
+void tkach::printStoredInFrame(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  Polygon target = readTarget(in);
+  if (store.size() == 0)
+  {
+    throw std::logic_error("Error: zero polygons");
+  }
+  out << (coversBox(store.frame(), getBox(target)) ? "<TRUE>" : "<FALSE>") << '\n';
+}
+
+void tkach::printStoredRects(std::ostream& out, const ColumnarStore& store)
+{
+  out << std::count(store.rects().cbegin(), store.rects().cend(), 1) << "\n";
+}
+
+void tkach::printStoredCount(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  std::map< std::string, CountPredicate > sub_cmds;
+  sub_cmds["EVEN"] = isEvenCount;
+  sub_cmds["ODD"] = isOddCount;
+  std::string sub_cmd;
+  in >> sub_cmd;
+  auto predicate = sub_cmds.find(sub_cmd);
+  CountPredicate selected = predicate != sub_cmds.end() ? predicate->second : makeEqualCount(sub_cmd);
+  out << countVertexes(store, selected) << "\n";
+}
+
+void tkach::printStoredArea(std::istream& in, std::ostream& out, const ColumnarStore& store)
+{
+  using area_map = std::map< std::string, std::function< double() > >;
+  StreamGuard guard(out);
+  area_map sub_cmds;
+  sub_cmds["EVEN"] = std::bind(sumAreas, std::cref(store), isEvenCount);
+  sub_cmds["ODD"] = std::bind(sumAreas, std::cref(store), isOddCount);
+  sub_cmds["MEAN"] = std::bind(meanArea, std::cref(store));
+  std::string sub_cmd;
+  in >> sub_cmd;
+  auto command = sub_cmds.find(sub_cmd);
+  double res = command != sub_cmds.end() ? command->second() : sumAreas(store, makeEqualCount(sub_cmd));
+  out << std::fixed << std::setprecision(1);
+  out << res << "\n";
+}
+#endif
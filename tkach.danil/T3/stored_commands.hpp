@@ -0,0 +1,18 @@
+#ifndef STORED_COMMANDS_HPP
+#define STORED_COMMANDS_HPP
+
+#include <iostream>
+#include "columnar_store.hpp"
+
+namespace tkach
+{
+  void printStoredArea(std::istream& in, std::ostream& out, const ColumnarStore& store);
+  void printStoredMax(std::istream& in, std::ostream& out, const ColumnarStore& store);
+  void printStoredMin(std::istream& in, std::ostream& out, const ColumnarStore& store);
+  void printStoredCount(std::istream& in, std::ostream& out, const ColumnarStore& store);
+  void printStoredSame(std::istream& in, std::ostream& out, const ColumnarStore& store);
+  void printStoredRects(std::ostream& out, const ColumnarStore& store);
+  void printStoredInFrame(std::istream& in, std::ostream& out, const ColumnarStore& store);
+}
+
+#endif